@@ -0,0 +1,43 @@
+/**
+ * @file AllocationCounter.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.10
+ */
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<size_t> allocationCount{0};
+}
+
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace UNO::BENCH {
+    AllocationCounter::AllocationCounter() : start_(allocationCount.load(std::memory_order_relaxed)) {}
+
+    size_t AllocationCounter::allocations() const
+    {
+        return allocationCount.load(std::memory_order_relaxed) - this->start_;
+    }
+}   // namespace UNO::BENCH
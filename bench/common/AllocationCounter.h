@@ -0,0 +1,31 @@
+/**
+ * @file AllocationCounter.h
+ *
+ * 统计堆分配次数，供基准测试报告每条消息的分配次数
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.10
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace UNO::BENCH {
+
+    /**
+     * 从构造时刻开始统计全局 operator new 的调用次数
+     */
+    class AllocationCounter {
+    private:
+        size_t start_;
+
+    public:
+        AllocationCounter();
+
+        /**
+         * @return 构造以来的堆分配次数
+         */
+        [[nodiscard]] size_t allocations() const;
+    };
+
+}   // namespace UNO::BENCH
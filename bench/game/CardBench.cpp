@@ -0,0 +1,74 @@
+/**
+ * @file CardBench.cpp
+ *
+ * 卡牌规则判断与手牌增删
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "../../src/game/Card.h"
+#include "../../src/game/Player.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace UNO::GAME;
+
+namespace {
+    /**
+     * 一副牌中所有不同的牌面
+     */
+    std::vector<Card> allFaces()
+    {
+        std::vector<Card> cards;
+        for (const auto color : AllColors) {
+            for (const auto type : AllTypes) {
+                cards.emplace_back(color, type);
+            }
+        }
+        return cards;
+    }
+}   // namespace
+
+/**
+ * 每次迭代判断所有牌面两两之间能否接着打出，累计摸牌数分别为 0 和 2
+ */
+static void BM_CardCanBePlayedOn(benchmark::State &state)
+{
+    const auto cards = allFaces();
+    for (auto _ : state) {
+        size_t playable = 0;
+        for (const auto &card : cards) {
+            for (const auto &top : cards) {
+                playable += card.canBePlayedOn(top, 0);
+                playable += card.canBePlayedOn(top, 2);
+            }
+        }
+        benchmark::DoNotOptimize(playable);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cards.size() * cards.size() * 2));
+}
+BENCHMARK(BM_CardCanBePlayedOn);
+
+/**
+ * 摸入 n 张牌后再逐张打出
+ */
+static void BM_HandCardDrawPlay(benchmark::State &state)
+{
+    const auto faces = allFaces();
+    std::vector<Card> cards;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        cards.push_back(faces[static_cast<size_t>(i * 7) % faces.size()]);
+    }
+
+    HandCard handCard;
+    for (auto _ : state) {
+        handCard.draw(cards);
+        for (const auto &card : cards) {
+            handCard.play(card);
+        }
+        benchmark::DoNotOptimize(handCard.isEmpty());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cards.size() * 2));
+}
+BENCHMARK(BM_HandCardDrawPlay)->Arg(7)->Arg(30);
@@ -0,0 +1,71 @@
+/**
+ * @file CardTileBench.cpp
+ *
+ * 起牌堆的初始化、洗牌与摸牌
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "../../src/game/CardTile.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace UNO::GAME;
+
+namespace {
+    /**
+     * 公开 CardTile::shuffle，单独测量洗牌
+     */
+    class ShuffleableDeck : public Deck {
+    public:
+        using CardTile::shuffle;
+    };
+
+    /**
+     * 一副完整的牌的张数
+     */
+    constexpr int64_t DeckSize = 108;
+}   // namespace
+
+/**
+ * 生成并洗混一副新牌
+ */
+static void BM_DeckInit(benchmark::State &state)
+{
+    for (auto _ : state) {
+        Deck deck;
+        deck.init();
+        benchmark::DoNotOptimize(deck.getCards().size());
+    }
+    state.SetItemsProcessed(state.iterations() * DeckSize);
+}
+BENCHMARK(BM_DeckInit);
+
+/**
+ * 洗混一副完整的牌
+ */
+static void BM_DeckShuffle(benchmark::State &state)
+{
+    ShuffleableDeck deck;
+    deck.init();
+    for (auto _ : state) {
+        deck.shuffle();
+        benchmark::DoNotOptimize(deck.getCards().front());
+    }
+    state.SetItemsProcessed(state.iterations() * DeckSize);
+}
+BENCHMARK(BM_DeckShuffle);
+
+/**
+ * 每次摸 n 张牌，牌堆摸空后由 Deck::draw 重新生成，重新生成的开销按比例计入
+ */
+static void BM_DeckDraw(benchmark::State &state)
+{
+    Deck deck;
+    deck.init();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(deck.draw(static_cast<size_t>(state.range(0))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DeckDraw)->Arg(1)->Arg(7);
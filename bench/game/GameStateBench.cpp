@@ -0,0 +1,95 @@
+/**
+ * @file GameStateBench.cpp
+ *
+ * 出牌、摸牌引起的游戏状态更新
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "../../src/game/GameState.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace UNO::GAME;
+
+namespace {
+    /**
+     * 首尾相接、每张都能打在前一张上的出牌序列，覆盖跳过、反转与万能牌，不累计摸牌数
+     */
+    const std::vector<Card> PlaySequence = {
+        {CardColor::RED, CardType::NUM1},
+        {CardColor::RED, CardType::NUM5},
+        {CardColor::GREEN, CardType::NUM5},
+        {CardColor::GREEN, CardType::SKIP},
+        {CardColor::GREEN, CardType::REVERSE},
+        {CardColor::BLUE, CardType::REVERSE},
+        {CardColor::BLUE, CardType::NUM3},
+        {CardColor::YELLOW, CardType::NUM3},
+        {CardColor::RED, CardType::WILD},
+    };
+
+    std::vector<ClientPlayerState> opponents(size_t count)
+    {
+        std::vector<ClientPlayerState> players;
+        for (size_t i = 0; i < count; i++) {
+            // 其他玩家只记录手牌数量，足够多的牌保证测量期间不会打完
+            players.emplace_back("player" + std::to_string(i), std::numeric_limits<size_t>::max() / 2, false);
+        }
+        return players;
+    }
+}   // namespace
+
+/**
+ * GameState::updateStateByCard 本身：客户端视角下其他玩家按固定序列出牌
+ */
+static void BM_GameStateUpdateStateByCard(benchmark::State &state)
+{
+    ClientGameState gameState;
+    auto players = opponents(static_cast<size_t>(state.range(0)));
+    // 自己坐在最后，出牌序列中的牌不需要在手牌中
+    gameState.init(std::move(players), DiscardSummary{PlaySequence.back(), 1}, {}, 0, static_cast<size_t>(state.range(0)) - 1);
+
+    size_t next = 0;
+    for (auto _ : state) {
+        gameState.updateStateByCard(PlaySequence[next]);
+        next = next + 1 == PlaySequence.size() ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GameStateUpdateStateByCard)->Arg(2)->Arg(4);
+
+/**
+ * 服务端的一个回合：当前玩家打出第一张能出的牌，没有则摸牌；有人出完后重新开局，开局的开销按比例计入
+ */
+static void BM_ServerGameStateTurn(benchmark::State &state)
+{
+    ServerGameState gameState;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        gameState.addPlayer(ServerPlayerState("player" + std::to_string(i), 0, false));
+    }
+    gameState.init();
+
+    int64_t games = 0;
+    for (auto _ : state) {
+        const auto &player = gameState.getPlayers()[gameState.getCurrentPlayerId()];
+        const auto &cards  = player.getCards();
+        auto card = std::ranges::find_if(cards, [&gameState](const Card &card) { return gameState.canPlay(card); });
+        if (card == cards.end()) {
+            benchmark::DoNotOptimize(gameState.updateStateByDraw());
+            continue;
+        }
+        gameState.updateStateByCard(*card);
+        if (std::ranges::any_of(gameState.getPlayers(), [](const ServerPlayerState &player) { return player.isEmpty(); })) {
+            gameState.endGame();
+            gameState.init();
+            games++;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["games"] = benchmark::Counter(static_cast<double>(games), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ServerGameStateTurn)->Arg(2)->Arg(4);
@@ -0,0 +1,156 @@
+/**
+ * @file ConnectionScaleBench.cpp
+ *
+ * 大量回环连接下的吞吐与往返延迟
+ *
+ * 分别在默认构建（epoll）和 UNO_ENABLE_IO_URING 构建下运行，用上下文中的 network_backend 区分结果
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.12
+ */
+#include "../../src/network/Session.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace UNO::NETWORK;
+
+namespace {
+    /**
+     * 单个监听端口承载的连接数，保证客户端的临时端口不会耗尽
+     */
+    constexpr size_t ConnectionsPerListener = 20000;
+
+    constexpr size_t MessageSize = 64;
+
+    using Clock = std::chrono::steady_clock;
+
+    const char *networkBackend()
+    {
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_DISABLE_EPOLL)
+        return "io_uring";
+#else
+        return "epoll";
+#endif
+    }
+
+    /**
+     * 把文件描述符上限提高到硬上限
+     * @return 当前可用的文件描述符数量
+     */
+    rlim_t raiseFileLimit()
+    {
+        rlimit limit{};
+        getrlimit(RLIMIT_NOFILE, &limit);
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        return limit.rlim_cur;
+    }
+
+    /**
+     * 一组回环连接：服务端 Session 原样回显，客户端 Session 记录每条消息的往返时间
+     */
+    class ConnectionPool {
+    private:
+        std::vector<std::unique_ptr<asio::ip::tcp::acceptor>> acceptors_;
+        std::vector<std::shared_ptr<Session>> servers_;
+        std::vector<std::shared_ptr<Session>> clients_;
+        std::vector<Clock::time_point> sentAt_;
+
+    public:
+        size_t received = 0;
+        std::vector<double> latencies;
+
+        ConnectionPool(asio::io_context &io_context, size_t connections)
+        {
+            this->sentAt_.resize(connections);
+            for (size_t i = 0; i < connections; i++) {
+                if (i % ConnectionsPerListener == 0) {
+                    this->acceptors_.push_back(std::make_unique<asio::ip::tcp::acceptor>(
+                        io_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0)));
+                }
+                auto &acceptor = *this->acceptors_.back();
+
+                asio::ip::tcp::socket clientSocket(io_context);
+                clientSocket.connect(acceptor.local_endpoint());
+
+                auto server = std::make_shared<Session>(acceptor.accept());
+                auto client = std::make_shared<Session>(std::move(clientSocket));
+
+                server->start([session = server.get()](std::string message) { session->send(message); });
+                client->start([this, i](std::string) {
+                    this->latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - this->sentAt_[i]).count());
+                    this->received++;
+                });
+
+                this->servers_.push_back(std::move(server));
+                this->clients_.push_back(std::move(client));
+            }
+        }
+
+        /**
+         * 每个连接各发送一条消息并等待全部回显
+         */
+        void roundTrip(asio::io_context &io_context, const std::string &message)
+        {
+            size_t expected = this->received + this->clients_.size();
+            for (size_t i = 0; i < this->clients_.size(); i++) {
+                this->sentAt_[i] = Clock::now();
+                this->clients_[i]->send(message);
+            }
+            while (this->received < expected) {
+                io_context.run_one();
+            }
+        }
+    };
+
+    double percentile(std::vector<double> &values, double p)
+    {
+        if (values.empty()) {
+            return 0;
+        }
+        auto nth = values.begin() + static_cast<std::ptrdiff_t>(p * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    }
+}   // namespace
+
+/**
+ * 所有连接同时收发一轮，统计消息吞吐与单条消息往返延迟的 p50 / p99
+ */
+static void BM_LoopbackConnections(benchmark::State &state)
+{
+    auto connections = static_cast<size_t>(state.range(0));
+    // 每个连接两端各占一个描述符，另外留出余量
+    if (raiseFileLimit() < 2 * connections + 64) {
+        state.SkipWithError("RLIMIT_NOFILE is too low for this connection count");
+        return;
+    }
+
+    asio::io_context io_context;
+    ConnectionPool pool(io_context, connections);
+
+    const std::string message(MessageSize, 'x');
+    pool.roundTrip(io_context, message);
+    pool.latencies.clear();
+
+    for (auto _ : state) {
+        pool.roundTrip(io_context, message);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * connections));
+    state.counters["p50_us"] = percentile(pool.latencies, 0.50);
+    state.counters["p99_us"] = percentile(pool.latencies, 0.99);
+}
+BENCHMARK(BM_LoopbackConnections)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+namespace {
+    const bool BackendContextRegistered = []() {
+        benchmark::AddCustomContext("network_backend", networkBackend());
+        return true;
+    }();
+}   // namespace
@@ -0,0 +1,120 @@
+/**
+ * @file MessageSerializerBench.cpp
+ *
+ * 每种负载类型在两种编码下的序列化与反序列化
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "../../src/network/MessageSerializer.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace UNO::NETWORK;
+using namespace UNO::GAME;
+
+namespace {
+    /**
+     * 一局四人游戏开局时的典型消息，PLAY_CARD 与 DRAW_CARD 是对局中最频繁的两种
+     */
+    Message sampleMessage(MessagePayloadType payloadType)
+    {
+        ServerGameState gameState;
+        for (int i = 0; i < 4; i++) {
+            gameState.addPlayer(ServerPlayerState("player" + std::to_string(i), 0, false));
+        }
+        gameState.init();
+
+        std::vector<ClientPlayerState> players;
+        for (const auto &player : gameState.getPlayers()) {
+            players.emplace_back(player.getName(), player.getRemainingCardCount(), player.getIsUno());
+        }
+        const auto &hand = gameState.getPlayers().front().getCards();
+        auto summary     = gameState.getDiscardPile().getSummary();
+
+        switch (payloadType) {
+            case MessagePayloadType::EMPTY:
+                return {MessageStatus::OK, payloadType, std::monostate{}};
+            case MessagePayloadType::JOIN_GAME:
+                return {MessageStatus::OK, payloadType, JoinGamePayload{"player0", "", NoSequence}};
+            case MessagePayloadType::START_GAME:
+                return {MessageStatus::OK, payloadType, StartGamePayload{}};
+            case MessagePayloadType::DRAW_CARD:
+                return {MessageStatus::OK, payloadType, DrawCardPayload{2, {*hand.begin(), *hand.rbegin()}}, 42};
+            case MessagePayloadType::PLAY_CARD:
+                return {MessageStatus::OK, payloadType, PlayCardPayload{Card(CardColor::RED, CardType::SKIP)}, 42};
+            case MessagePayloadType::INIT_GAME:
+                return {MessageStatus::OK, payloadType, InitGamePayload{0, players, summary, hand, 0, std::nullopt}, 1};
+            case MessagePayloadType::END_GAME:
+                return {MessageStatus::OK, payloadType, EndGamePayload{}, 42};
+            case MessagePayloadType::ACK:
+                return {MessageStatus::OK, payloadType, AckPayload{42}};
+            case MessagePayloadType::SYNC_REQUEST:
+                return {MessageStatus::OK, payloadType, SyncRequestPayload{40}};
+            case MessagePayloadType::SYNC:
+                return {MessageStatus::OK, payloadType, SyncPayload{0, players, summary, hand, 0, false, 0}, 42};
+            case MessagePayloadType::SESSION:
+                return {MessageStatus::OK, payloadType, SessionPayload{std::string(32, 'f')}};
+        }
+        std::unreachable();
+    }
+
+    constexpr int64_t PayloadTypeCount = std::to_underlying(MessagePayloadType::SESSION) + 1;
+
+    /**
+     * 参数为 {负载类型, 编码}，结果以负载类型和编码命名
+     */
+    void applyMessageArguments(benchmark::internal::Benchmark *benchmark)
+    {
+        benchmark->ArgNames({"type", "binary"});
+        for (int64_t type = 0; type < PayloadTypeCount; type++) {
+            benchmark->Args({type, 0});
+            benchmark->Args({type, 1});
+        }
+    }
+
+    Message messageFor(benchmark::State &state)
+    {
+        auto payloadType = static_cast<MessagePayloadType>(state.range(0));
+        state.SetLabel(std::string(MessageSerializer::serializeMessagePayloadType(payloadType)));
+        return sampleMessage(payloadType);
+    }
+
+    MessageEncoding encodingFor(const benchmark::State &state)
+    {
+        return state.range(1) == 0 ? MessageEncoding::JSON : MessageEncoding::BINARY;
+    }
+}   // namespace
+
+/**
+ * 序列化到复用的缓冲区，与 UnoServer 发送时的用法一致
+ */
+static void BM_MessageSerialize(benchmark::State &state)
+{
+    auto message  = messageFor(state);
+    auto encoding = encodingFor(state);
+
+    std::string buffer;
+    for (auto _ : state) {
+        MessageSerializer::serialize(message, buffer, encoding);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+BENCHMARK(BM_MessageSerialize)->Apply(applyMessageArguments);
+
+/**
+ * 完整反序列化，包括消息头与负载
+ */
+static void BM_MessageDeserialize(benchmark::State &state)
+{
+    auto data = MessageSerializer::serialize(messageFor(state), encodingFor(state));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MessageSerializer::deserialize(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_MessageDeserialize)->Apply(applyMessageArguments);
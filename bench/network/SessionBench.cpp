@@ -0,0 +1,121 @@
+/**
+ * @file SessionBench.cpp
+ *
+ * Session 回环收发：吞吐与每条消息的堆分配次数
+ *
+ * 只依赖 Session 的 start / send 接口，可以直接在旧提交上运行以对比不同实现
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.10
+ */
+#include "../../src/network/Session.h"
+#include "../common/AllocationCounter.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+using namespace UNO::NETWORK;
+
+namespace {
+    /**
+     * 一对通过回环连接的 Session，服务端把收到的消息原样发回
+     */
+    struct LoopbackPair {
+        std::shared_ptr<Session> server;
+        std::shared_ptr<Session> client;
+
+        LoopbackPair(asio::io_context &io_context, asio::ip::tcp::acceptor &acceptor, size_t &received)
+        {
+            asio::ip::tcp::socket clientSocket(io_context);
+            clientSocket.connect(acceptor.local_endpoint());
+
+            server = std::make_shared<Session>(acceptor.accept());
+            client = std::make_shared<Session>(std::move(clientSocket));
+
+            server->start([session = server.get()](std::string message) { session->send(message); });
+            client->start([&received](std::string) { received++; });
+        }
+    };
+
+    void reportAllocations(benchmark::State &state, const UNO::BENCH::AllocationCounter &counter, size_t messagesPerIteration)
+    {
+        auto allocations = static_cast<double>(counter.allocations());
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messagesPerIteration));
+        state.counters["allocs_per_msg"] =
+            benchmark::Counter(allocations / static_cast<double>(messagesPerIteration), benchmark::Counter::kAvgIterations);
+        state.counters["allocs_per_sec"] = benchmark::Counter(allocations, benchmark::Counter::kIsRate);
+    }
+}   // namespace
+
+/**
+ * 单个连接上的往返
+ */
+static void BM_SessionRoundTrip(benchmark::State &state)
+{
+    // io_context 必须最后析构：挂起的协程 / 回调持有 Session 的 shared_ptr
+    asio::io_context io_context;
+    asio::ip::tcp::acceptor acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    size_t received = 0;
+    LoopbackPair pair(io_context, acceptor, received);
+
+    const std::string message(static_cast<size_t>(state.range(0)), 'x');
+    auto roundTrip = [&]() {
+        size_t expected = received + 1;
+        pair.client->send(message);
+        while (received < expected) {
+            io_context.run_one();
+        }
+    };
+
+    // 预热，排除首次收发时的一次性分配
+    for (int i = 0; i < 16; i++) {
+        roundTrip();
+    }
+
+    UNO::BENCH::AllocationCounter counter;
+    for (auto _ : state) {
+        roundTrip();
+    }
+    // 每次往返包含两条消息
+    reportAllocations(state, counter, 2);
+}
+BENCHMARK(BM_SessionRoundTrip)->Arg(64)->Arg(4096);
+
+/**
+ * 同一线程上多个连接同时收发，模拟负载下处理器内存的交错分配
+ */
+static void BM_SessionRoundTripUnderLoad(benchmark::State &state)
+{
+    asio::io_context io_context;
+    asio::ip::tcp::acceptor acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    size_t received = 0;
+    std::vector<std::unique_ptr<LoopbackPair>> pairs;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        pairs.push_back(std::make_unique<LoopbackPair>(io_context, acceptor, received));
+    }
+
+    const std::string message(64, 'x');
+    auto roundTrip = [&]() {
+        size_t expected = received + pairs.size();
+        for (const auto &pair : pairs) {
+            pair->client->send(message);
+        }
+        while (received < expected) {
+            io_context.run_one();
+        }
+    };
+
+    for (int i = 0; i < 16; i++) {
+        roundTrip();
+    }
+
+    UNO::BENCH::AllocationCounter counter;
+    for (auto _ : state) {
+        roundTrip();
+    }
+    reportAllocations(state, counter, 2 * pairs.size());
+}
+BENCHMARK(BM_SessionRoundTripUnderLoad)->Arg(16)->Arg(256);
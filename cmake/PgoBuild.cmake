@@ -0,0 +1,49 @@
+# 以 LTO 与 PGO 构建 uno-server 的完整流程
+#
+#   cmake -D BINARY_DIR=build-pgo -P cmake/PgoBuild.cmake
+#
+# 1. 以 UNO_PGO=GENERATE 构建插桩的二进制
+# 2. 运行 uno-pgo-train，用模拟对局与序列化基准生成剖析数据
+# 3. 在同一构建目录中改为 UNO_PGO=USE 重新构建，并用 uno-sim 测量吞吐
+#
+# 可选参数：
+#   -D WITH_BENCHMARKS=OFF  没有安装 Google Benchmark 时只用模拟对局训练
+#   -D CONFIGURE_ARGS="..." 传给两次配置的额外参数，以分号分隔
+
+cmake_minimum_required(VERSION 4.0)
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if (NOT DEFINED BINARY_DIR)
+    set(BINARY_DIR "${SOURCE_DIR}/build-pgo")
+endif ()
+if (NOT DEFINED WITH_BENCHMARKS)
+    set(WITH_BENCHMARKS ON)
+endif ()
+
+function(uno_pgo_run)
+    execute_process(COMMAND ${ARGV} COMMAND_ECHO STDOUT RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "PGO step failed: ${ARGV}")
+    endif ()
+endfunction()
+
+set(common_args
+        -S "${SOURCE_DIR}"
+        -B "${BINARY_DIR}"
+        -D CMAKE_BUILD_TYPE=Release
+        -D UNO_ENABLE_LTO=ON
+        -D UNO_BUILD_UI=OFF
+        -D UNO_BUILD_BENCHMARKS=${WITH_BENCHMARKS}
+        -D UNO_PGO_PROFILE_DIR=${BINARY_DIR}/pgo-profile
+        ${CONFIGURE_ARGS}
+)
+
+# 旧的剖析数据与新的代码不匹配，每次都重新训练
+file(REMOVE_RECURSE "${BINARY_DIR}/pgo-profile")
+
+uno_pgo_run(${CMAKE_COMMAND} ${common_args} -D UNO_PGO=GENERATE)
+uno_pgo_run(${CMAKE_COMMAND} --build "${BINARY_DIR}" --target uno-pgo-train)
+
+uno_pgo_run(${CMAKE_COMMAND} ${common_args} -D UNO_PGO=USE)
+uno_pgo_run(${CMAKE_COMMAND} --build "${BINARY_DIR}" --target uno-server uno-sim)
+uno_pgo_run("${BINARY_DIR}/uno-sim" --players 4 --duration 10)
@@ -0,0 +1,64 @@
+/**
+ * @file BotPolicy.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "BotPolicy.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace UNO::CLIENT {
+    BotPolicy::BotPolicy() : isReadied_(false) {}
+
+    std::optional<GAME::Card> BotPolicy::chooseCard(const GAME::ClientGameState &gameState)
+    {
+        const auto &cards = gameState.getCards();
+        auto card         = std::ranges::find_if(cards, [&gameState](const GAME::Card &card) { return gameState.canPlay(card); });
+        if (card == cards.end()) {
+            return std::nullopt;
+        }
+        if (card->getType() != GAME::CardType::WILD && card->getType() != GAME::CardType::WILDDRAWFOUR) {
+            return *card;
+        }
+
+        std::array<size_t, GAME::AllColors.size()> counts{};
+        for (const auto &held : cards) {
+            if (held.getType() != GAME::CardType::WILD && held.getType() != GAME::CardType::WILDDRAWFOUR) {
+                counts[std::to_underlying(held.getColor())]++;
+            }
+        }
+        auto color = static_cast<GAME::CardColor>(std::ranges::max_element(counts) - counts.begin());
+        return GAME::Card(color, card->getType());
+    }
+
+    void BotPolicy::onUpdate(ClientCore &core)
+    {
+        auto gameState = core.getGameState();
+        if (gameState->getClientGameStage() == GAME::ClientGameStage::AFTER_GAME) {
+            if (this->isReadied_ == false) {
+                this->isReadied_ = true;
+                core.ready();
+            }
+            return;
+        }
+        this->isReadied_ = false;
+
+        if (gameState->getClientGameStage() != GAME::ClientGameStage::ACTIVE || core.isWaiting()) {
+            return;
+        }
+        // 有玩家出完了牌，服务端随后会发来 END_GAME
+        const auto &players = gameState->getPlayers();
+        if (std::ranges::any_of(players, [](const GAME::ClientPlayerState &player) { return player.getRemainingCardCount() == 0; })) {
+            return;
+        }
+
+        if (auto card = chooseCard(*gameState)) {
+            core.playCard(*card);
+            return;
+        }
+        core.drawCard();
+    }
+}   // namespace UNO::CLIENT
@@ -0,0 +1,38 @@
+/**
+ * @file BotPolicy.h
+ *
+ * 自动出牌的决策者，供无界面客户端与模拟器使用
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#pragma once
+#include "ClientCore.h"
+
+#include <optional>
+
+namespace UNO::CLIENT {
+
+    class BotPolicy : public ClientPolicy {
+    private:
+        /**
+         * 这一局结束后是否已经再次准备
+         */
+        bool isReadied_;
+
+    public:
+        BotPolicy();
+
+        /**
+         * 轮到自己且没有等待中的操作时，打出第一张能出的牌，没有则摸牌；每局结束后自动再次准备
+         */
+        void onUpdate(ClientCore &core) override;
+
+        /**
+         * @param gameState 客户端的游戏状态
+         * @return 手牌中第一张能打出的牌，万能牌选择手牌中最多的颜色；没有能出的牌时为 std::nullopt
+         */
+        static std::optional<GAME::Card> chooseCard(const GAME::ClientGameState &gameState);
+    };
+
+}   // namespace UNO::CLIENT
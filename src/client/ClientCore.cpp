@@ -0,0 +1,245 @@
+/**
+ * @file ClientCore.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "ClientCore.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace UNO::CLIENT {
+    ClientCore::ClientCore(NETWORK::MessageEncoding encoding,
+                           std::function<void(std::shared_ptr<const std::string>)> send,
+                           ClientPolicy &policy) :
+        clientGameState_(std::make_shared<GAME::ClientGameState>()),
+        send_(std::move(send)),
+        policy_(policy),
+        encoding_(encoding),
+        lastSequence_(NETWORK::NoSequence),
+        lastAcked_(NETWORK::NoSequence),
+        isResyncing_(false),
+        isWaiting_(false),
+        gamesEnded_(0),
+        rejected_(0)
+    {
+    }
+
+    void ClientCore::setPlayerName(const std::string &name)
+    {
+        this->clientGameState_->setPlayerName(name);
+    }
+
+    void ClientCore::send(const NETWORK::Message &message)
+    {
+        this->send_(std::make_shared<const std::string>(NETWORK::MessageSerializer::serialize(message, this->encoding_)));
+    }
+
+    void ClientCore::handleConnected()
+    {
+        // 已经拿到恢复令牌说明这是重连：取回原来的座位，服务端只补发错过的事件，客户端状态保持不变
+        this->send({NETWORK::MessageStatus::OK,
+                    NETWORK::MessagePayloadType::JOIN_GAME,
+                    NETWORK::JoinGamePayload{this->clientGameState_->getPlayerName(), this->resumeToken_, this->lastSequence_}});
+
+        if (this->resumeToken_.empty()) {
+            this->clientGameState_->setClientGameStageConnected();
+        }
+        this->policy_.onUpdate(*this);
+    }
+
+    void ClientCore::handleInitGame(NETWORK::InitGamePayload &&payload)
+    {
+        // 服务端开启调试选项时才会附带完整的弃牌堆
+        if (payload.discardPile.has_value()) {
+            this->clientGameState_->init(std::move(payload.players),
+                                         std::move(*payload.discardPile),
+                                         std::move(payload.handCard),
+                                         payload.currentPlayerIndex,
+                                         payload.playerId);
+            return;
+        }
+        this->clientGameState_->init(std::move(payload.players),
+                                     payload.discardSummary,
+                                     std::move(payload.handCard),
+                                     payload.currentPlayerIndex,
+                                     payload.playerId);
+    }
+
+    void ClientCore::handlePlayCard(const NETWORK::PlayCardPayload &payload)
+    {
+        if (this->clientGameState_->getClientGameStage() == GAME::ClientGameStage::ACTIVE) {
+            this->clientGameState_->play(payload.card);
+            this->isWaiting_ = false;
+        }
+        this->clientGameState_->updateStateByCard(payload.card);
+    }
+
+    void ClientCore::handleDrawCard(const NETWORK::DrawCardPayload &payload)
+    {
+        if (this->clientGameState_->getClientGameStage() == GAME::ClientGameStage::ACTIVE) {
+            this->clientGameState_->draw(payload.cards);
+            this->isWaiting_ = false;
+        }
+        this->clientGameState_->updateStateByDraw();
+    }
+
+    void ClientCore::handleEndGame(const NETWORK::EndGamePayload &payload)
+    {
+        this->clientGameState_->endGame();
+        this->isWaiting_ = false;
+        this->gamesEnded_++;
+    }
+
+    void ClientCore::handleSync(NETWORK::SyncPayload &&payload)
+    {
+        this->clientGameState_->sync(std::move(payload.players),
+                                     payload.discardSummary,
+                                     std::move(payload.handCard),
+                                     payload.currentPlayerIndex,
+                                     payload.playerId,
+                                     payload.isReversed,
+                                     payload.drawCount);
+        this->isWaiting_ = false;
+    }
+
+    void ClientCore::handleSession(NETWORK::SessionPayload &&payload)
+    {
+        this->resumeToken_ = std::move(payload.resumeToken);
+    }
+
+    bool ClientCore::acceptSequence(const NETWORK::MessageView &message)
+    {
+        auto sequence = message.getSequence();
+        // 不带序号的消息来自不支持状态流的服务端，按到达顺序应用
+        if (sequence == NETWORK::NoSequence) {
+            return true;
+        }
+
+        // 快照包含完整的状态，不要求与之前的事件连续
+        if (message.getMessagePayloadType() == NETWORK::MessagePayloadType::INIT_GAME
+            || message.getMessagePayloadType() == NETWORK::MessagePayloadType::SYNC) {
+            return sequence >= this->lastSequence_;
+        }
+
+        if (sequence <= this->lastSequence_) {
+            return false;
+        }
+        if (sequence != this->lastSequence_ + 1) {
+            if (this->isResyncing_ == false) {
+                this->isResyncing_ = true;
+                this->send({NETWORK::MessageStatus::OK,
+                            NETWORK::MessagePayloadType::SYNC_REQUEST,
+                            NETWORK::SyncRequestPayload{this->lastSequence_}});
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void ClientCore::acknowledge()
+    {
+        this->send({NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::ACK, NETWORK::AckPayload{this->lastSequence_}});
+        this->lastAcked_ = this->lastSequence_;
+    }
+
+    void ClientCore::handleMessage(const std::string &message)
+    {
+        // 先根据消息头拒绝不应由服务端发送的消息，再解码负载
+        NETWORK::MessageView networkMessage(message);
+        // 服务端拒绝了上一条消息，游戏状态没有变化
+        if (networkMessage.getMessageStatus() == NETWORK::MessageStatus::INVALID) {
+            this->isWaiting_ = false;
+            this->rejected_++;
+            return;
+        }
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::EMPTY
+            || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::JOIN_GAME
+            || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::START_GAME
+            || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::ACK
+            || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::SYNC_REQUEST) {
+            throw std::invalid_argument("Invalid message type from server");
+        }
+        if (this->acceptSequence(networkMessage) == false) {
+            return;
+        }
+
+        // 负载从临时消息中移出，INIT_GAME 的牌堆与手牌随后再移入 ClientGameState，全程不复制
+        auto payload = networkMessage.decode().getMessagePayload();
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::INIT_GAME) {
+            this->handleInitGame(std::get<NETWORK::InitGamePayload>(std::move(payload)));
+        }
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::DRAW_CARD) {
+            this->handleDrawCard(std::get<NETWORK::DrawCardPayload>(payload));
+        }
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::PLAY_CARD) {
+            this->handlePlayCard(std::get<NETWORK::PlayCardPayload>(payload));
+        }
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::END_GAME) {
+            this->handleEndGame(std::get<NETWORK::EndGamePayload>(payload));
+        }
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::SYNC) {
+            this->handleSync(std::get<NETWORK::SyncPayload>(std::move(payload)));
+        }
+        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::SESSION) {
+            this->handleSession(std::get<NETWORK::SessionPayload>(std::move(payload)));
+        }
+
+        if (networkMessage.getSequence() != NETWORK::NoSequence) {
+            this->lastSequence_ = networkMessage.getSequence();
+            this->isResyncing_  = false;
+            // 快照之后立即确认，使服务端可以丢弃更早的事件
+            if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::INIT_GAME
+                || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::SYNC
+                || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::END_GAME
+                || this->lastSequence_ - this->lastAcked_ >= AckInterval) {
+                this->acknowledge();
+            }
+        }
+
+        this->policy_.onUpdate(*this);
+    }
+
+    void ClientCore::ready()
+    {
+        this->send_(NETWORK::MessageSerializer::startGameFrame(this->encoding_));
+    }
+
+    void ClientCore::playCard(const GAME::Card &card)
+    {
+        this->isWaiting_ = true;
+        this->send_(NETWORK::MessageSerializer::playCardFrame(card, this->encoding_));
+    }
+
+    void ClientCore::drawCard()
+    {
+        this->isWaiting_ = true;
+        this->send({NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::DRAW_CARD, NETWORK::DrawCardPayload{}});
+    }
+
+    std::shared_ptr<const GAME::ClientGameState> ClientCore::getGameState() const
+    {
+        return this->clientGameState_;
+    }
+
+    bool ClientCore::hasJoined() const
+    {
+        return this->resumeToken_.empty() == false;
+    }
+
+    bool ClientCore::isWaiting() const
+    {
+        return this->isWaiting_;
+    }
+
+    uint64_t ClientCore::getGamesEnded() const
+    {
+        return this->gamesEnded_;
+    }
+
+    uint64_t ClientCore::getRejected() const
+    {
+        return this->rejected_;
+    }
+}   // namespace UNO::CLIENT
@@ -0,0 +1,172 @@
+/**
+ * @file ClientCore.h
+ *
+ * 与界面无关的客户端核心：处理服务端消息、维护 ClientGameState，并把出牌等操作编码后交给传输层
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#pragma once
+#include "../game/GameState.h"
+#include "../network/Message.h"
+#include "../network/MessageSerializer.h"
+#include "../network/MessageView.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace UNO::CLIENT {
+    class ClientCore;
+
+    /**
+     * 客户端的决策者：图形界面把状态显示给玩家，机器人自动出牌
+     */
+    class ClientPolicy {
+    public:
+        virtual ~ClientPolicy() = default;
+
+        /**
+         * 连接建立后以及每次应用服务端消息后调用，与 ClientCore 在同一线程上执行
+         * @param core 客户端核心，可以通过它准备、出牌或摸牌
+         */
+        virtual void onUpdate(ClientCore &core) = 0;
+    };
+
+    class ClientCore {
+    private:
+        std::shared_ptr<GAME::ClientGameState> clientGameState_;
+
+        /**
+         * 发送一条已经编码的消息
+         */
+        std::function<void(std::shared_ptr<const std::string>)> send_;
+        ClientPolicy &policy_;
+
+        /**
+         * 发送消息使用的编码，服务器在 JOIN_GAME 时记录并以同样的编码回复
+         */
+        NETWORK::MessageEncoding encoding_;
+
+        /**
+         * 已经应用的最后一个状态事件的序号
+         */
+        uint64_t lastSequence_;
+
+        /**
+         * 最后一次向服务端确认的序号
+         */
+        uint64_t lastAcked_;
+
+        /**
+         * 是否已经发出补齐请求且尚未收到缺失的事件，避免每个乱序的事件都重复请求
+         */
+        bool isResyncing_;
+
+        /**
+         * 服务端发放的恢复令牌，重连时用它取回原来的座位
+         */
+        std::string resumeToken_;
+
+        /**
+         * 已经发出出牌或摸牌，尚未收到服务端的广播
+         */
+        bool isWaiting_;
+
+        uint64_t gamesEnded_;
+        uint64_t rejected_;
+
+        /**
+         * 每应用这么多个事件确认一次，服务端据此丢弃所有玩家都已应用的事件
+         */
+        static constexpr uint64_t AckInterval = 8;
+
+    private:
+        void handleInitGame(NETWORK::InitGamePayload &&payload);
+        void handlePlayCard(const NETWORK::PlayCardPayload &payload);
+        void handleDrawCard(const NETWORK::DrawCardPayload &payload);
+        void handleEndGame(const NETWORK::EndGamePayload &payload);
+        void handleSync(NETWORK::SyncPayload &&payload);
+        void handleSession(NETWORK::SessionPayload &&payload);
+
+        /**
+         * 检查状态事件的序号
+         * @param message 收到的消息
+         * @return 是否应用该消息；重复的事件被丢弃，出现缺口时向服务端请求补齐
+         */
+        bool acceptSequence(const NETWORK::MessageView &message);
+
+        /**
+         * 向服务端确认已经应用的事件
+         */
+        void acknowledge();
+
+        void send(const NETWORK::Message &message);
+
+    public:
+        /**
+         * @param encoding 发送消息使用的编码
+         * @param send 发送一条已经编码的消息
+         * @param policy 决策者，必须比 ClientCore 活得更久
+         */
+        ClientCore(NETWORK::MessageEncoding encoding, std::function<void(std::shared_ptr<const std::string>)> send, ClientPolicy &policy);
+
+        /**
+         * 设置玩家名字，在连接之前调用
+         */
+        void setPlayerName(const std::string &name);
+
+        /**
+         * 连接建立后加入游戏；已经拿到恢复令牌时取回原来的座位
+         */
+        void handleConnected();
+
+        /**
+         * 处理服务端消息
+         * @param message 收到的消息
+         */
+        void handleMessage(const std::string &message);
+
+        /**
+         * 准备开始游戏
+         */
+        void ready();
+
+        /**
+         * 出牌
+         * @param card 要打出的牌，万能牌的颜色为选择的颜色
+         */
+        void playCard(const GAME::Card &card);
+
+        /**
+         * 摸牌
+         */
+        void drawCard();
+
+        /**
+         * @return 客户端的游戏状态
+         */
+        [[nodiscard]] std::shared_ptr<const GAME::ClientGameState> getGameState() const;
+
+        /**
+         * @return 是否已经收到服务端分配的座位，断线后可以凭恢复令牌重连
+         */
+        [[nodiscard]] bool hasJoined() const;
+
+        /**
+         * @return 是否已经出牌或摸牌，正在等待服务端的广播
+         */
+        [[nodiscard]] bool isWaiting() const;
+
+        /**
+         * @return 已经结束的局数
+         */
+        [[nodiscard]] uint64_t getGamesEnded() const;
+
+        /**
+         * @return 被服务端拒绝的消息数
+         */
+        [[nodiscard]] uint64_t getRejected() const;
+    };
+
+}   // namespace UNO::CLIENT
@@ -0,0 +1,92 @@
+/**
+ * @file HeadlessClient.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "HeadlessClient.h"
+
+#include <thread>
+#include <utility>
+
+namespace UNO::CLIENT {
+    HeadlessClient::HeadlessClient(HeadlessOptions options) :
+        options_(std::move(options)),
+        core_(this->options_.encoding,
+              [this](std::shared_ptr<const std::string> message) { this->networkClient_->send(std::move(message)); },
+              *this),
+        isReadyDue_(false),
+        isReadied_(false),
+        isFailed_(false)
+    {
+        this->networkClient_ = std::make_shared<NETWORK::NetworkClient>(
+            [this]() { this->core_.handleConnected(); },
+            [this](const std::string &message) { this->core_.handleMessage(message); },
+            [this]() { this->handleNetworkDisconnected(); },
+            [this]() { this->handleConnectFailed(); });
+        this->core_.setPlayerName(this->options_.name);
+    }
+
+    void HeadlessClient::handleNetworkDisconnected()
+    {
+        // 还没有入座时重连只会占用新的座位，直接退出
+        if (this->core_.hasJoined()) {
+            this->networkClient_->reconnect();
+            return;
+        }
+        this->isFailed_ = true;
+        this->networkClient_->stop();
+    }
+
+    void HeadlessClient::handleConnectFailed()
+    {
+        this->isFailed_ = true;
+        this->networkClient_->stop();
+    }
+
+    void HeadlessClient::readyIfDue(ClientCore &core)
+    {
+        if (this->isReadyDue_ && this->isReadied_ == false && core.hasJoined()
+            && core.getGameState()->getClientGameStage() == GAME::ClientGameStage::PRE_GAME) {
+            this->isReadied_ = true;
+            core.ready();
+        }
+    }
+
+    void HeadlessClient::onUpdate(ClientCore &core)
+    {
+        if (this->options_.games != 0 && core.getGamesEnded() >= this->options_.games) {
+            this->networkClient_->stop();
+            return;
+        }
+        if (core.getGameState()->getClientGameStage() == GAME::ClientGameStage::PRE_GAME) {
+            this->readyIfDue(core);
+            return;
+        }
+        this->bot_.onUpdate(core);
+    }
+
+    bool HeadlessClient::run()
+    {
+        std::thread networkThread([this]() { this->networkClient_->run(); });
+        this->networkClient_->connect(this->options_.host, this->options_.port);
+
+        std::this_thread::sleep_for(this->options_.readyDelay);
+        this->networkClient_->post([this]() {
+            this->isReadyDue_ = true;
+            this->readyIfDue(this->core_);
+        });
+        networkThread.join();
+        return this->isFailed_ == false;
+    }
+
+    uint64_t HeadlessClient::getGamesEnded() const
+    {
+        return this->core_.getGamesEnded();
+    }
+
+    uint64_t HeadlessClient::getRejected() const
+    {
+        return this->core_.getRejected();
+    }
+}   // namespace UNO::CLIENT
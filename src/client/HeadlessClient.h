@@ -0,0 +1,87 @@
+/**
+ * @file HeadlessClient.h
+ *
+ * 不依赖界面的客户端，由 BotPolicy 自动出牌，用于在服务器上做负载与浸泡测试
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#pragma once
+#include "../network/NetworkClient.h"
+#include "BotPolicy.h"
+#include "ClientCore.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace UNO::CLIENT {
+
+    struct HeadlessOptions {
+        std::string name;
+        std::string host;
+        uint16_t port;
+        NETWORK::MessageEncoding encoding = NETWORK::MessageEncoding::BINARY;
+
+        /**
+         * 打完这么多局后退出，为 0 时一直运行
+         */
+        uint64_t games = 0;
+
+        /**
+         * 连接后等待这么久才准备开局，让其他客户端有时间加入同一局
+         */
+        std::chrono::milliseconds readyDelay = std::chrono::seconds(1);
+    };
+
+    class HeadlessClient : public ClientPolicy {
+    private:
+        HeadlessOptions options_;
+        std::shared_ptr<NETWORK::NetworkClient> networkClient_;
+        ClientCore core_;
+        BotPolicy bot_;
+
+        /**
+         * 准备开局的等待时间已经过去；以下两个成员只在网络线程上访问
+         */
+        bool isReadyDue_;
+        bool isReadied_;
+
+        /**
+         * 连接失败、重连次数用尽或入座前连接断开，在网络线程上写入，run 返回前读取
+         */
+        bool isFailed_;
+
+    private:
+        void handleNetworkDisconnected();
+        void handleConnectFailed();
+
+        /**
+         * 等待时间已经过去且已经入座时准备第一局，之后每局由 BotPolicy 自动准备
+         */
+        void readyIfDue(ClientCore &core);
+
+    public:
+        explicit HeadlessClient(HeadlessOptions options);
+
+        /**
+         * 连接服务端并自动对局，阻塞直到打完配置的局数或无法再连上服务端
+         * @return 是否没有因为连接失败而提前结束
+         */
+        bool run();
+
+        void onUpdate(ClientCore &core) override;
+
+        /**
+         * @return 已经结束的局数
+         */
+        [[nodiscard]] uint64_t getGamesEnded() const;
+
+        /**
+         * @return 被服务端拒绝的消息数
+         */
+        [[nodiscard]] uint64_t getRejected() const;
+    };
+
+}   // namespace UNO::CLIENT
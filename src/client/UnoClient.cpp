@@ -6,75 +6,36 @@
  */
 #include "UnoClient.h"
 
-#include "../network/Message.h"
-#include "../network/MessageSerializer.h"
-
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
 namespace UNO::CLIENT {
     void UnoClient::handleNetworkConnected()
     {
-        NETWORK::JoinGamePayload messagePayload = {this->clientGameState_->getPlayerName()};
-        NETWORK::Message message                = {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::JOIN_GAME, messagePayload};
-        networkClient_->send(NETWORK::MessageSerializer::serialize(message));
-
-        this->clientGameState_->setClientGameStageConnected();
-        gameUI_->updateUI(this->clientGameState_);
-    }
-
-    void UnoClient::handleNetworkInitGame(const NETWORK::InitGamePayload &payload)
-    {
-        this->clientGameState_->init(payload.players, payload.discardPile, payload.handCard, payload.currentPlayerIndex, payload.playerId);
-    }
-
-    void UnoClient::handleNetworkPlayCard(const NETWORK::PlayCardPayload &payload)
-    {
-        if (clientGameState_->getClientGameStage() == GAME::ClientGameStage::ACTIVE) {
-            clientGameState_->play(payload.card);
-        }
-        clientGameState_->updateStateByCard(payload.card);
+        this->core_.handleConnected();
     }
 
-    void UnoClient::handleNetworkDrawCard(const NETWORK::DrawCardPayload &payload)
+    void UnoClient::handleNetworkDisconnected()
     {
-        if (clientGameState_->getClientGameStage() == GAME::ClientGameStage::ACTIVE) {
-            clientGameState_->draw(payload.cards);
+        // 还没有拿到恢复令牌时重连只会占用新的座位，交给玩家重新连接
+        if (this->core_.hasJoined()) {
+            networkClient_->reconnect();
         }
-        clientGameState_->updateStateByDraw();
     }
 
-    void UnoClient::handleNetworkEndGame(const NETWORK::EndGamePayload &payload)
+    void UnoClient::onUpdate(ClientCore &core)
     {
-        this->clientGameState_->endGame();
+        gameUI_->updateUI(core.getGameState());
     }
 
-    void UnoClient::handleNetworkMessage(const std::string &message)
+    void UnoClient::handlePlayerAction(PlayerAction action)
     {
-        auto networkMessage = NETWORK::MessageSerializer::deserialize(message);
-        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::INIT_GAME) {
-            this->handleNetworkInitGame(std::get<NETWORK::InitGamePayload>(networkMessage.getMessagePayload()));
-        }
-        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::DRAW_CARD) {
-            this->handleNetworkDrawCard(std::get<NETWORK::DrawCardPayload>(networkMessage.getMessagePayload()));
-        }
-        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::PLAY_CARD) {
-            this->handleNetworkPlayCard(std::get<NETWORK::PlayCardPayload>(networkMessage.getMessagePayload()));
-        }
-        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::END_GAME) {
-            this->handleNetworkEndGame(std::get<NETWORK::EndGamePayload>(networkMessage.getMessagePayload()));
-        }
-
-        if (networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::EMPTY
-            || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::JOIN_GAME
-            || networkMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::START_GAME) {
-            throw std::invalid_argument("Invalid message type from server");
-        }
-
-        gameUI_->updateUI(this->clientGameState_);
+        // 界面回调在 Slint 的事件循环线程上执行，ClientCore 只在网络线程上访问，转到网络线程处理，避免和收到的消息并发修改状态
+        networkClient_->post([this, action = std::move(action)]() { this->dispatchPlayerAction(action); });
     }
 
-    void UnoClient::handlePlayerAction(PlayerAction action)
+    void UnoClient::dispatchPlayerAction(const PlayerAction &action)
     {
         if (action.playerActionType == PlayerActionType::CONNECT) {
             this->handlePlayerConnect(std::get<PlayerConnectPayload>(action.payload));
@@ -93,21 +54,19 @@ namespace UNO::CLIENT {
 
     void UnoClient::handlePlayerConnect(const PlayerConnectPayload &payload)
     {
-        clientGameState_->setPlayerName(payload.playerName);
+        this->core_.setPlayerName(payload.playerName);
         networkClient_->connect(payload.host, payload.port);
     }
 
 
     void UnoClient::handlePlayerStartGame(PlayerStartGamePayload payload)
     {
-        NETWORK::StartGamePayload messagePayload = {};
-        NETWORK::Message message                 = {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::START_GAME, messagePayload};
-        networkClient_->send(NETWORK::MessageSerializer::serialize(message));
+        this->core_.ready();
     }
 
     void UnoClient::handlePlayerPlayCard(PlayerPlayCardPayload payload)
     {
-        auto cards = this->clientGameState_->getCards();
+        auto cards = this->core_.getGameState()->getCards();
         auto card  = cards.begin();
         for (size_t i = 0; i < payload.id; i++) {
             card = std::next(card);
@@ -118,26 +77,22 @@ namespace UNO::CLIENT {
             throw std::invalid_argument("Invalid card played by player");
         }
 
-        NETWORK::PlayCardPayload messagePayload = {
-            {(card->getType() != GAME::CardType::WILD && card->getType() != GAME::CardType::WILDDRAWFOUR) ? card->getColor()
-                                                                                                          : payload.color,
-             card->getType()}};
-        NETWORK::Message message = {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::PLAY_CARD, messagePayload};
-        networkClient_->send(NETWORK::MessageSerializer::serialize(message));
+        auto isWild = card->getType() == GAME::CardType::WILD || card->getType() == GAME::CardType::WILDDRAWFOUR;
+        this->core_.playCard({isWild ? payload.color : card->getColor(), card->getType()});
     }
 
     void UnoClient::handlePlayerDrawCard(PlayerDrawCardPayload payload)
     {
-        NETWORK::DrawCardPayload messagePayload = {};
-        NETWORK::Message message                = {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::DRAW_CARD, messagePayload};
-        networkClient_->send(NETWORK::MessageSerializer::serialize(message));
+        this->core_.drawCard();
     }
 
-    UnoClient::UnoClient()
+    UnoClient::UnoClient(NETWORK::MessageEncoding encoding) :
+        core_(encoding, [this](std::shared_ptr<const std::string> message) { this->networkClient_->send(std::move(message)); }, *this)
     {
-        clientGameState_ = std::make_shared<GAME::ClientGameState>();
-        networkClient_   = std::make_shared<NETWORK::NetworkClient>(
-            [this]() { this->handleNetworkConnected(); }, [this](const std::string &message) { this->handleNetworkMessage(message); });
+        networkClient_ = std::make_shared<NETWORK::NetworkClient>(
+            [this]() { this->handleNetworkConnected(); },
+            [this](const std::string &message) { this->core_.handleMessage(message); },
+            [this]() { this->handleNetworkDisconnected(); });
         gameUI_ = std::make_shared<UI::GameUI>([this](const PlayerAction &action) { this->handlePlayerAction(action); });
     }
 
@@ -154,4 +109,4 @@ namespace UNO::CLIENT {
         networkThread_ = std::thread([this]() { this->networkClient_->run(); });
         gameUI_->run();
     }
-}   // namespace UNO::CLIENT
\ No newline at end of file
+}   // namespace UNO::CLIENT
@@ -5,10 +5,10 @@
  * @date 2025.12.06
  */
 #pragma once
-#include "../game/GameState.h"
-#include "../network/Message.h"
+#include "../network/MessageSerializer.h"
 #include "../network/NetworkClient.h"
 #include "../ui/GameUI.h"
+#include "ClientCore.h"
 #include "PlayerAction.h"
 
 #include <memory>
@@ -16,37 +16,40 @@
 
 
 namespace UNO::CLIENT {
-    class UnoClient {
+    class UnoClient : public ClientPolicy {
     private:
-        std::shared_ptr<GAME::ClientGameState> clientGameState_;
         std::shared_ptr<UI::GameUI> gameUI_;
         std::shared_ptr<NETWORK::NetworkClient> networkClient_;
+        ClientCore core_;
 
         std::thread networkThread_;
 
     private:
         void handleNetworkConnected();
-
-        void handleNetworkMessage(const std::string &message);
-
-        void handleNetworkInitGame(const NETWORK::InitGamePayload &payload);
-        void handleNetworkPlayCard(const NETWORK::PlayCardPayload &payload);
-        void handleNetworkDrawCard(const NETWORK::DrawCardPayload &payload);
-        void handleNetworkEndGame(const NETWORK::EndGamePayload &payload);
-
+        void handleNetworkDisconnected();
 
         void handlePlayerAction(PlayerAction action);
 
+        /**
+         * 在网络线程上执行玩家的操作
+         */
+        void dispatchPlayerAction(const PlayerAction &action);
+
         void handlePlayerConnect(const PlayerConnectPayload &payload);
         void handlePlayerStartGame(PlayerStartGamePayload payload);
         void handlePlayerPlayCard(PlayerPlayCardPayload payload);
         void handlePlayerDrawCard(PlayerDrawCardPayload payload);
 
     public:
-        UnoClient();
+        explicit UnoClient(NETWORK::MessageEncoding encoding = NETWORK::MessageEncoding::BINARY);
         ~UnoClient();
 
         void run();
+
+        /**
+         * 把客户端状态显示到界面上
+         */
+        void onUpdate(ClientCore &core) override;
     };
 
 }   // namespace UNO::CLIENT
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "UnoClient.h"
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 int main()
 {
@@ -9,8 +11,10 @@ int main()
     return 0;
 }
 
+#ifdef _WIN32
 int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPTSTR lpCmdLine, int nCmdShow)
 {
     main();
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,93 @@
+/**
+ * @file BinaryCodec.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.13
+ */
+#include "BinaryCodec.h"
+
+#include "Utf8.h"
+
+#include <stdexcept>
+
+namespace UNO::COMMON {
+    BinaryWriter::BinaryWriter() = default;
+
+    void BinaryWriter::writeByte(uint8_t value)
+    {
+        this->buffer_.push_back(static_cast<char>(value));
+    }
+
+    void BinaryWriter::writeVarint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            this->writeByte(static_cast<uint8_t>(value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        this->writeByte(static_cast<uint8_t>(value));
+    }
+
+    void BinaryWriter::writeString(std::string_view value)
+    {
+        this->writeVarint(value.size());
+        this->buffer_.append(value);
+    }
+
+    const std::string &BinaryWriter::getData() const
+    {
+        return this->buffer_;
+    }
+
+    std::string BinaryWriter::release()
+    {
+        return std::move(this->buffer_);
+    }
+
+    BinaryReader::BinaryReader(std::string_view data) : data_(data), position_(0) {}
+
+    uint8_t BinaryReader::readByte()
+    {
+        if (this->isEnd()) {
+            throw std::invalid_argument("Unexpected end of binary data");
+        }
+        return static_cast<uint8_t>(this->data_[this->position_++]);
+    }
+
+    uint64_t BinaryReader::readVarint()
+    {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = this->readByte();
+            result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return result;
+            }
+        }
+        throw std::invalid_argument("Invalid varint: longer than 10 bytes");
+    }
+
+    std::string BinaryReader::readString()
+    {
+        uint64_t length = this->readVarint();
+        if (length > this->remaining()) {
+            throw std::invalid_argument("Invalid string length: exceeds remaining binary data");
+        }
+        auto value = this->data_.substr(this->position_, length);
+        // 与 JSON 编码一致：读到的字符串可能被转发给 JSON 客户端，不合法的 UTF-8 在这里就拒绝
+        if (isValidUtf8(value) == false) {
+            throw std::invalid_argument("Invalid string: not valid UTF-8");
+        }
+        this->position_ += length;
+        return std::string(value);
+    }
+
+    size_t BinaryReader::remaining() const
+    {
+        return this->data_.size() - this->position_;
+    }
+
+    bool BinaryReader::isEnd() const
+    {
+        return this->position_ == this->data_.size();
+    }
+}   // namespace UNO::COMMON
@@ -0,0 +1,92 @@
+/**
+ * @file BinaryCodec.h
+ *
+ * 紧凑二进制编码的读写工具
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.13
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace UNO::COMMON {
+    /**
+     * 向缓冲区追加字节、变长整数与带长度前缀的字符串
+     */
+    class BinaryWriter {
+    private:
+        std::string buffer_;
+
+    public:
+        BinaryWriter();
+
+        /**
+         * 写入一个字节
+         * @param value 要写入的字节
+         */
+        void writeByte(uint8_t value);
+
+        /**
+         * 以 LEB128 变长编码写入无符号整数，小于 128 的值只占一个字节
+         * @param value 要写入的整数
+         */
+        void writeVarint(uint64_t value);
+
+        /**
+         * 写入变长整数表示的长度，再写入字符串内容
+         * @param value 要写入的字符串
+         */
+        void writeString(std::string_view value);
+
+        /**
+         * @return 已写入的数据
+         */
+        [[nodiscard]] const std::string &getData() const;
+
+        /**
+         * 取出已写入的数据，之后缓冲区为空
+         * @return 已写入的数据
+         */
+        std::string release();
+    };
+
+    /**
+     * 按 BinaryWriter 的格式读取数据，数据不完整或格式错误时抛出 std::invalid_argument
+     */
+    class BinaryReader {
+    private:
+        std::string_view data_;
+        size_t position_;
+
+    public:
+        explicit BinaryReader(std::string_view data);
+
+        /**
+         * @return 读到的字节
+         */
+        uint8_t readByte();
+
+        /**
+         * @return 读到的 LEB128 变长整数
+         */
+        uint64_t readVarint();
+
+        /**
+         * @return 读到的带长度前缀的字符串，不是合法 UTF-8 时抛出 std::invalid_argument
+         */
+        std::string readString();
+
+        /**
+         * @return 尚未读取的字节数
+         */
+        [[nodiscard]] size_t remaining() const;
+
+        /**
+         * @return 是否已读完所有数据
+         */
+        [[nodiscard]] bool isEnd() const;
+    };
+}   // namespace UNO::COMMON
@@ -0,0 +1,434 @@
+/**
+ * @file JsonReader.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.15
+ */
+#include "JsonReader.h"
+
+#include "Utf8.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace UNO::COMMON {
+    JsonReader::JsonReader(std::string_view data) : data_(data), position_(0), isFirst_(false)
+    {
+        if (this->data_.starts_with("\xEF\xBB\xBF")) {
+            this->position_ = 3;
+        }
+    }
+
+    void JsonReader::fail()
+    {
+        throw std::invalid_argument("Invalid JSON body");
+    }
+
+    char JsonReader::current() const
+    {
+        if (this->position_ >= this->data_.size()) {
+            fail();
+        }
+        return this->data_[this->position_];
+    }
+
+    void JsonReader::skipWhitespace()
+    {
+        while (this->position_ < this->data_.size()) {
+            char c = this->data_[this->position_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                return;
+            }
+            this->position_++;
+        }
+    }
+
+    void JsonReader::expect(char c)
+    {
+        if (this->current() != c) {
+            fail();
+        }
+        this->position_++;
+    }
+
+    uint32_t JsonReader::readHex4()
+    {
+        uint32_t result = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = this->current();
+            result <<= 4;
+            if (c >= '0' && c <= '9') {
+                result |= c - '0';
+            }
+            else if (c >= 'a' && c <= 'f') {
+                result |= c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F') {
+                result |= c - 'A' + 10;
+            }
+            else {
+                fail();
+            }
+            this->position_++;
+        }
+        return result;
+    }
+
+    void JsonReader::parseString(std::string *out)
+    {
+        this->expect('"');
+        size_t runStart = this->position_;
+        while (true) {
+            auto byte = static_cast<uint8_t>(this->current());
+            if (byte == '"') {
+                if (out != nullptr) {
+                    out->append(this->data_.substr(runStart, this->position_ - runStart));
+                }
+                this->position_++;
+                return;
+            }
+            if (byte < 0x20) {
+                fail();
+            }
+            if (byte >= 0x80) {
+                size_t length = utf8SequenceLength(this->data_, this->position_);
+                if (length == 0) {
+                    fail();
+                }
+                this->position_ += length;
+                continue;
+            }
+            if (byte != '\\') {
+                this->position_++;
+                continue;
+            }
+
+            if (out != nullptr) {
+                out->append(this->data_.substr(runStart, this->position_ - runStart));
+            }
+            this->position_++;
+            char escaped = this->current();
+            this->position_++;
+            char simple = 0;
+            switch (escaped) {
+                case '"': simple = '"'; break;
+                case '\\': simple = '\\'; break;
+                case '/': simple = '/'; break;
+                case 'b': simple = '\b'; break;
+                case 'f': simple = '\f'; break;
+                case 'n': simple = '\n'; break;
+                case 'r': simple = '\r'; break;
+                case 't': simple = '\t'; break;
+                case 'u': break;
+                default: fail();
+            }
+
+            if (escaped != 'u') {
+                if (out != nullptr) {
+                    out->push_back(simple);
+                }
+            }
+            else {
+                uint32_t codePoint = this->readHex4();
+                if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    fail();
+                }
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    // 高代理必须紧跟低代理
+                    this->expect('\\');
+                    this->expect('u');
+                    uint32_t low = this->readHex4();
+                    if (low < 0xDC00 || low > 0xDFFF) {
+                        fail();
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+
+                if (out != nullptr) {
+                    if (codePoint < 0x80) {
+                        out->push_back(static_cast<char>(codePoint));
+                    }
+                    else if (codePoint < 0x800) {
+                        out->push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                        out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    }
+                    else if (codePoint < 0x10000) {
+                        out->push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                        out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                        out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    }
+                    else {
+                        out->push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                        out->push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                        out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                        out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    }
+                }
+            }
+            runStart = this->position_;
+        }
+    }
+
+    void JsonReader::parseNumber(JsonNumber *out)
+    {
+        size_t start  = this->position_;
+        auto isDigit  = [this]() { return this->position_ < this->data_.size() && this->data_[this->position_] >= '0'
+                                         && this->data_[this->position_] <= '9'; };
+        bool isSigned = false;
+        bool isFloat  = false;
+        bool overflow = false;
+        uint64_t value = 0;
+
+        if (this->current() == '-') {
+            isSigned = true;
+            this->position_++;
+        }
+        if (this->current() == '0') {
+            this->position_++;
+        }
+        else if (isDigit()) {
+            while (isDigit()) {
+                uint64_t digit = this->data_[this->position_] - '0';
+                if (value > (UINT64_MAX - digit) / 10) {
+                    overflow = true;
+                }
+                value = value * 10 + digit;
+                this->position_++;
+            }
+        }
+        else {
+            fail();
+        }
+
+        if (this->position_ < this->data_.size() && this->data_[this->position_] == '.') {
+            isFloat = true;
+            this->position_++;
+            if (isDigit() == false) {
+                fail();
+            }
+            while (isDigit()) {
+                this->position_++;
+            }
+        }
+        if (this->position_ < this->data_.size() && (this->data_[this->position_] == 'e' || this->data_[this->position_] == 'E')) {
+            isFloat = true;
+            this->position_++;
+            if (this->position_ < this->data_.size() && (this->data_[this->position_] == '+' || this->data_[this->position_] == '-')) {
+                this->position_++;
+            }
+            if (isDigit() == false) {
+                fail();
+            }
+            while (isDigit()) {
+                this->position_++;
+            }
+        }
+
+        // 不能表示为整数的数字按 double 处理，与 nlohmann::json 一样拒绝超出 double 范围的值
+        if (isFloat || overflow) {
+            std::string text(this->data_.substr(start, this->position_ - start));
+            if (std::isfinite(std::strtod(text.c_str(), nullptr)) == false) {
+                fail();
+            }
+        }
+
+        if (out != nullptr) {
+            *out = {isSigned == false && isFloat == false && overflow == false, value};
+        }
+    }
+
+    void JsonReader::parseLiteral(std::string_view literal)
+    {
+        if (this->data_.substr(this->position_, literal.size()) != literal) {
+            fail();
+        }
+        this->position_ += literal.size();
+    }
+
+    void JsonReader::skipMemberKey()
+    {
+        this->skipWhitespace();
+        this->parseString(nullptr);
+        this->skipWhitespace();
+        this->expect(':');
+    }
+
+    JsonType JsonReader::peek()
+    {
+        this->skipWhitespace();
+        switch (this->current()) {
+            case '{': return JsonType::OBJECT;
+            case '[': return JsonType::ARRAY;
+            case '"': return JsonType::STRING;
+            case 't':
+            case 'f': return JsonType::BOOLEAN;
+            case 'n': return JsonType::NULL_VALUE;
+            case '-':
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9': return JsonType::NUMBER;
+            default: fail();
+        }
+    }
+
+    void JsonReader::beginObject()
+    {
+        this->skipWhitespace();
+        this->expect('{');
+        this->isFirst_ = true;
+    }
+
+    bool JsonReader::nextMember(std::string &key)
+    {
+        this->skipWhitespace();
+        if (this->current() == '}') {
+            this->position_++;
+            this->isFirst_ = false;
+            return false;
+        }
+        if (this->isFirst_ == false) {
+            this->expect(',');
+            this->skipWhitespace();
+        }
+        this->isFirst_ = false;
+
+        key.clear();
+        this->parseString(&key);
+        this->skipWhitespace();
+        this->expect(':');
+        return true;
+    }
+
+    void JsonReader::beginArray()
+    {
+        this->skipWhitespace();
+        this->expect('[');
+        this->isFirst_ = true;
+    }
+
+    bool JsonReader::nextElement()
+    {
+        this->skipWhitespace();
+        if (this->current() == ']') {
+            this->position_++;
+            this->isFirst_ = false;
+            return false;
+        }
+        if (this->isFirst_ == false) {
+            this->expect(',');
+        }
+        this->isFirst_ = false;
+        return true;
+    }
+
+    std::string JsonReader::readString()
+    {
+        this->skipWhitespace();
+        std::string result;
+        this->parseString(&result);
+        return result;
+    }
+
+    JsonNumber JsonReader::readNumber()
+    {
+        this->skipWhitespace();
+        JsonNumber result{};
+        this->parseNumber(&result);
+        return result;
+    }
+
+    bool JsonReader::readBool()
+    {
+        this->skipWhitespace();
+        if (this->current() == 't') {
+            this->parseLiteral("true");
+            return true;
+        }
+        this->parseLiteral("false");
+        return false;
+    }
+
+    void JsonReader::readNull()
+    {
+        this->skipWhitespace();
+        this->parseLiteral("null");
+    }
+
+    std::string_view JsonReader::skipValue()
+    {
+        this->skipWhitespace();
+        size_t start = this->position_;
+
+        // 尚未闭合的容器的结束符，用显式的栈代替递归
+        std::string closers;
+        while (true) {
+            this->skipWhitespace();
+            char c = this->current();
+            if (c == '{' || c == '[') {
+                char closer = c == '{' ? '}' : ']';
+                this->position_++;
+                this->skipWhitespace();
+                if (this->current() != closer) {
+                    closers.push_back(closer);
+                    if (closer == '}') {
+                        this->skipMemberKey();
+                    }
+                    continue;
+                }
+                this->position_++;
+            }
+            else if (c == '"') {
+                this->parseString(nullptr);
+            }
+            else if (c == 't') {
+                this->parseLiteral("true");
+            }
+            else if (c == 'f') {
+                this->parseLiteral("false");
+            }
+            else if (c == 'n') {
+                this->parseLiteral("null");
+            }
+            else {
+                this->parseNumber(nullptr);
+            }
+
+            // 一个值读完，处理外层容器的逗号或结束符
+            while (closers.empty() == false) {
+                this->skipWhitespace();
+                char next = this->current();
+                if (next == ',') {
+                    this->position_++;
+                    if (closers.back() == '}') {
+                        this->skipMemberKey();
+                    }
+                    break;
+                }
+                if (next != closers.back()) {
+                    fail();
+                }
+                this->position_++;
+                closers.pop_back();
+            }
+            if (closers.empty()) {
+                return this->data_.substr(start, this->position_ - start);
+            }
+        }
+    }
+
+    void JsonReader::expectEnd()
+    {
+        this->skipWhitespace();
+        if (this->position_ != this->data_.size()) {
+            fail();
+        }
+    }
+}   // namespace UNO::COMMON
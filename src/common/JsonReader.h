@@ -0,0 +1,103 @@
+/**
+ * @file JsonReader.h
+ *
+ * 不构建 DOM 的流式 JSON 读取器
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.15
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace UNO::COMMON {
+    /**
+     * JSON 值的类型
+     */
+    enum class JsonType { NULL_VALUE, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    /**
+     * 读到的数字；只有不带符号、小数与指数且不超过 uint64_t 范围的整数才是无符号整数，与 nlohmann::json 的分类一致
+     */
+    struct JsonNumber {
+        bool isUnsigned;
+        uint64_t value;
+    };
+
+    /**
+     * 按顺序读取 JSON 文本
+     *
+     * 语法规则与 nlohmann::json::parse 相同（包括 UTF-8 校验、代理对与开头的 BOM），
+     * 任何语法错误都抛出 std::invalid_argument("Invalid JSON body")
+     */
+    class JsonReader {
+    private:
+        std::string_view data_;
+        size_t position_;
+
+        /**
+         * 当前容器中还没有读取任何元素
+         */
+        bool isFirst_;
+
+        [[noreturn]] static void fail();
+
+        char current() const;
+        void skipWhitespace();
+        void expect(char c);
+
+        uint32_t readHex4();
+        void parseString(std::string *out);
+        void parseNumber(JsonNumber *out);
+        void parseLiteral(std::string_view literal);
+        void skipMemberKey();
+
+    public:
+        explicit JsonReader(std::string_view data);
+
+        /**
+         * @return 下一个值的类型，只看首字符，不消费任何内容
+         */
+        JsonType peek();
+
+        /**
+         * 开始读取对象，之后用 nextMember 遍历成员
+         */
+        void beginObject();
+
+        /**
+         * 读取下一个成员的键与冒号，调用者随后读取成员的值
+         * @param key 用于保存键的缓冲区
+         * @return 对象已结束时返回 false
+         */
+        bool nextMember(std::string &key);
+
+        /**
+         * 开始读取数组，之后用 nextElement 遍历元素
+         */
+        void beginArray();
+
+        /**
+         * @return 还有下一个元素时返回 true，调用者随后读取元素；数组已结束时返回 false
+         */
+        bool nextElement();
+
+        std::string readString();
+        JsonNumber readNumber();
+        bool readBool();
+        void readNull();
+
+        /**
+         * 跳过下一个值并校验它的语法，嵌套深度不受调用栈限制
+         * @return 被跳过的值的原始文本
+         */
+        std::string_view skipValue();
+
+        /**
+         * 确认之后只剩空白
+         */
+        void expectEnd();
+    };
+}   // namespace UNO::COMMON
@@ -0,0 +1,131 @@
+/**
+ * @file JsonWriter.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.14
+ */
+#include "JsonWriter.h"
+
+#include "Utf8.h"
+
+#include <charconv>
+#include <stdexcept>
+
+namespace UNO::COMMON {
+    JsonWriter::JsonWriter(std::string &buffer) : buffer_(buffer), isFirst_(true), isAfterKey_(false) {}
+
+    void JsonWriter::writeSeparator()
+    {
+        if (this->isAfterKey_) {
+            this->isAfterKey_ = false;
+            return;
+        }
+        if (this->isFirst_ == false) {
+            this->buffer_.push_back(',');
+        }
+        this->isFirst_ = false;
+    }
+
+    void JsonWriter::writeEscaped(std::string_view value)
+    {
+        static constexpr char hexDigits[] = "0123456789abcdef";
+
+        this->buffer_.push_back('"');
+        size_t runStart = 0;
+        for (size_t i = 0; i < value.size();) {
+            auto byte = static_cast<uint8_t>(value[i]);
+            if (byte >= 0x20 && byte != '"' && byte != '\\' && byte < 0x80) {
+                i++;
+                continue;
+            }
+            if (byte >= 0x80) {
+                size_t length = utf8SequenceLength(value, i);
+                if (length == 0) {
+                    throw std::invalid_argument("Invalid UTF-8 byte at index " + std::to_string(i) + " in JSON string");
+                }
+                i += length;
+                continue;
+            }
+
+            this->buffer_.append(value.substr(runStart, i - runStart));
+            switch (byte) {
+                case '"': this->buffer_.append("\\\""); break;
+                case '\\': this->buffer_.append("\\\\"); break;
+                case '\b': this->buffer_.append("\\b"); break;
+                case '\f': this->buffer_.append("\\f"); break;
+                case '\n': this->buffer_.append("\\n"); break;
+                case '\r': this->buffer_.append("\\r"); break;
+                case '\t': this->buffer_.append("\\t"); break;
+                default:
+                    this->buffer_.append("\\u00");
+                    this->buffer_.push_back(hexDigits[byte >> 4]);
+                    this->buffer_.push_back(hexDigits[byte & 0x0F]);
+                    break;
+            }
+            i++;
+            runStart = i;
+        }
+        this->buffer_.append(value.substr(runStart));
+        this->buffer_.push_back('"');
+    }
+
+    void JsonWriter::beginObject()
+    {
+        this->writeSeparator();
+        this->buffer_.push_back('{');
+        this->isFirst_ = true;
+    }
+
+    void JsonWriter::endObject()
+    {
+        this->buffer_.push_back('}');
+        this->isFirst_ = false;
+    }
+
+    void JsonWriter::beginArray()
+    {
+        this->writeSeparator();
+        this->buffer_.push_back('[');
+        this->isFirst_ = true;
+    }
+
+    void JsonWriter::endArray()
+    {
+        this->buffer_.push_back(']');
+        this->isFirst_ = false;
+    }
+
+    void JsonWriter::key(std::string_view key)
+    {
+        this->writeSeparator();
+        this->writeEscaped(key);
+        this->buffer_.push_back(':');
+        this->isAfterKey_ = true;
+    }
+
+    void JsonWriter::stringValue(std::string_view value)
+    {
+        this->writeSeparator();
+        this->writeEscaped(value);
+    }
+
+    void JsonWriter::numberValue(uint64_t value)
+    {
+        this->writeSeparator();
+        char digits[20];
+        auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), value);
+        this->buffer_.append(digits, end);
+    }
+
+    void JsonWriter::boolValue(bool value)
+    {
+        this->writeSeparator();
+        this->buffer_.append(value ? "true" : "false");
+    }
+
+    void JsonWriter::nullValue()
+    {
+        this->writeSeparator();
+        this->buffer_.append("null");
+    }
+}   // namespace UNO::COMMON
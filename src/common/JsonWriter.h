@@ -0,0 +1,66 @@
+/**
+ * @file JsonWriter.h
+ *
+ * 不构建 DOM 的 JSON 文本写入器
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.14
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace UNO::COMMON {
+    /**
+     * 把 JSON 文本直接追加到外部缓冲区
+     *
+     * 输出与 nlohmann::json::dump() 的紧凑格式逐字节一致：无空白，字符串转义规则相同，
+     * 非 ASCII 字符按 UTF-8 原样输出；对象的键由调用者按字典序写入
+     */
+    class JsonWriter {
+    private:
+        std::string &buffer_;
+
+        /**
+         * 当前容器中还没有写入任何元素
+         */
+        bool isFirst_;
+
+        /**
+         * 刚写完一个键，下一个值不需要逗号
+         */
+        bool isAfterKey_;
+
+        void writeSeparator();
+        void writeEscaped(std::string_view value);
+
+    public:
+        /**
+         * @param buffer 输出缓冲区，写入的内容追加在末尾
+         */
+        explicit JsonWriter(std::string &buffer);
+
+        void beginObject();
+        void endObject();
+        void beginArray();
+        void endArray();
+
+        /**
+         * 写入对象的键
+         * @param key 键
+         */
+        void key(std::string_view key);
+
+        /**
+         * 写入字符串值，字符串不是合法 UTF-8 时抛出 std::invalid_argument
+         * @param value 字符串
+         */
+        void stringValue(std::string_view value);
+
+        void numberValue(uint64_t value);
+        void boolValue(bool value);
+        void nullValue();
+    };
+}   // namespace UNO::COMMON
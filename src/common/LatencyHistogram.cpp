@@ -0,0 +1,83 @@
+/**
+ * @file LatencyHistogram.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+namespace UNO::COMMON {
+    namespace {
+        constexpr uint64_t SubBucketCount     = uint64_t{1} << LatencyHistogram::PrecisionBits;
+        constexpr uint64_t HalfSubBucketCount = SubBucketCount / 2;
+        constexpr uint64_t MaxValue           = (uint64_t{1} << LatencyHistogram::MaxBits) - 1;
+    }   // namespace
+
+    size_t LatencyHistogram::bucketOf(uint64_t nanoseconds)
+    {
+        auto value = std::min(nanoseconds, MaxValue);
+        if (value < SubBucketCount) {
+            return value;
+        }
+        // 第 shift 个区间 [2^(shift + P - 1), 2^(shift + P)) 中的值右移 shift 位后落在 [2^(P - 1), 2^P)
+        auto shift = static_cast<uint64_t>(std::bit_width(value)) - PrecisionBits;
+        return shift * HalfSubBucketCount + (value >> shift);
+    }
+
+    uint64_t LatencyHistogram::upperBound(size_t bucket)
+    {
+        if (bucket < SubBucketCount) {
+            return bucket;
+        }
+        auto shift    = bucket / HalfSubBucketCount - 1;
+        auto subValue = bucket - shift * HalfSubBucketCount;
+        return ((subValue + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds latency)
+    {
+        auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+        this->buckets_[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        this->count_.fetch_add(1, std::memory_order_relaxed);
+        this->sum_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    uint64_t LatencyHistogram::getCount() const
+    {
+        return this->count_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t LatencyHistogram::getSum() const
+    {
+        return this->sum_.load(std::memory_order_relaxed);
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::percentile(double quantile) const
+    {
+        // 与其他线程的记录并发时，以这里读到的各个桶为准
+        std::array<uint64_t, BucketCount> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < BucketCount; i++) {
+            counts[i] = this->buckets_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        if (total == 0) {
+            return std::chrono::nanoseconds::zero();
+        }
+
+        auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total))));
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < BucketCount; i++) {
+            cumulative += counts[i];
+            if (cumulative >= target) {
+                return std::chrono::nanoseconds(upperBound(i));
+            }
+        }
+        std::unreachable();
+    }
+}   // namespace UNO::COMMON
@@ -0,0 +1,79 @@
+/**
+ * @file LatencyHistogram.h
+ *
+ * HDR 风格的延迟直方图
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace UNO::COMMON {
+
+    /**
+     * 对数-线性分桶的延迟直方图
+     *
+     * 每个 2 的幂区间再等分为 2^(PrecisionBits - 1) 个桶，任意值的相对误差不超过 2^-(PrecisionBits - 1)，
+     * 高百分位（p99、p999）也能准确读出；记录只是一次 relaxed 原子加，不加锁
+     */
+    class LatencyHistogram {
+    public:
+        /**
+         * 精度位数，7 位对应不超过 1/64 的相对误差
+         */
+        static constexpr unsigned PrecisionBits = 7;
+
+        /**
+         * 可以区分的最大值为 2^MaxBits 纳秒（约 18 分钟），更大的值记入最后一个桶
+         */
+        static constexpr unsigned MaxBits = 40;
+
+        static constexpr size_t BucketCount = (MaxBits - PrecisionBits + 2) << (PrecisionBits - 1);
+
+    private:
+        std::array<std::atomic<uint64_t>, BucketCount> buckets_{};
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> sum_{0};
+
+    public:
+        /**
+         * @param nanoseconds 延迟（纳秒）
+         * @return 延迟所在的桶
+         */
+        static size_t bucketOf(uint64_t nanoseconds);
+
+        /**
+         * @param bucket 桶的下标
+         * @return 落在该桶中的最大值（纳秒）
+         */
+        static uint64_t upperBound(size_t bucket);
+
+        /**
+         * 记录一次延迟
+         * @param latency 延迟
+         */
+        void record(std::chrono::nanoseconds latency);
+
+        /**
+         * @return 记录的次数
+         */
+        [[nodiscard]] uint64_t getCount() const;
+
+        /**
+         * @return 所有延迟之和（纳秒）
+         */
+        [[nodiscard]] uint64_t getSum() const;
+
+        /**
+         * @param quantile 分位数，范围为 [0, 1]
+         * @return 不小于该比例的记录的最小桶上界；没有记录时为 0
+         */
+        [[nodiscard]] std::chrono::nanoseconds percentile(double quantile) const;
+    };
+
+}   // namespace UNO::COMMON
@@ -0,0 +1,119 @@
+/**
+ * @file Metrics.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#include "Metrics.h"
+
+#include <algorithm>
+#include <format>
+
+namespace UNO::COMMON {
+    void Counter::add(uint64_t count)
+    {
+        this->value_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t Counter::get() const
+    {
+        return this->value_.load(std::memory_order_relaxed);
+    }
+
+    void Gauge::add(int64_t delta)
+    {
+        this->value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void Gauge::set(int64_t value)
+    {
+        this->value_.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t Gauge::get() const
+    {
+        return this->value_.load(std::memory_order_relaxed);
+    }
+
+    void Histogram::observe(std::chrono::nanoseconds duration)
+    {
+        auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+        auto bucket      = std::ranges::lower_bound(BucketBounds, nanoseconds) - BucketBounds.begin();
+        this->buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        this->sum_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    uint64_t Histogram::getBucket(size_t bucket) const
+    {
+        return this->buckets_.at(bucket).load(std::memory_order_relaxed);
+    }
+
+    uint64_t Histogram::getSum() const
+    {
+        return this->sum_.load(std::memory_order_relaxed);
+    }
+
+    ScopedTimer::ScopedTimer(Histogram &histogram) : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+    ScopedTimer::~ScopedTimer()
+    {
+        this->histogram_.observe(std::chrono::steady_clock::now() - this->start_);
+    }
+
+    void PrometheusWriter::sample(std::string_view name, std::string_view suffix, std::string_view labels, std::string_view value)
+    {
+        this->text_.append(name).append(suffix);
+        if (labels.empty() == false) {
+            this->text_.append("{").append(labels).append("}");
+        }
+        this->text_.append(" ").append(value).append("\n");
+    }
+
+    void PrometheusWriter::family(std::string_view name, std::string_view help, std::string_view type)
+    {
+        this->text_.append(std::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type));
+    }
+
+    void PrometheusWriter::write(std::string_view name, std::string_view labels, const Counter &counter)
+    {
+        this->sample(name, "", labels, std::to_string(counter.get()));
+    }
+
+    void PrometheusWriter::write(std::string_view name, std::string_view labels, const Gauge &gauge)
+    {
+        this->sample(name, "", labels, std::to_string(gauge.get()));
+    }
+
+    void PrometheusWriter::write(std::string_view name, std::string_view labels, const Histogram &histogram)
+    {
+        // 各个桶分别读取，累计值在这里计算，_count 取最后一个桶的累计值以保证与桶一致
+        std::string separator = labels.empty() ? "" : ",";
+        uint64_t cumulative   = 0;
+        for (size_t i = 0; i <= Histogram::BucketBounds.size(); i++) {
+            cumulative += histogram.getBucket(i);
+            std::string bound = "+Inf";
+            if (i < Histogram::BucketBounds.size()) {
+                bound = std::format("{}", static_cast<double>(Histogram::BucketBounds[i]) / 1e9);
+            }
+            this->sample(name, "_bucket", std::format("{}{}le=\"{}\"", labels, separator, bound), std::to_string(cumulative));
+        }
+        this->sample(name, "_sum", labels, std::format("{}", static_cast<double>(histogram.getSum()) / 1e9));
+        this->sample(name, "_count", labels, std::to_string(cumulative));
+    }
+
+    void PrometheusWriter::write(std::string_view name, std::string_view labels, const LatencyHistogram &histogram)
+    {
+        std::string separator = labels.empty() ? "" : ",";
+        for (auto quantile : {0.5, 0.99, 0.999}) {
+            auto value = std::chrono::duration<double>(histogram.percentile(quantile)).count();
+            this->sample(name, "", std::format("{}{}quantile=\"{}\"", labels, separator, quantile), std::format("{}", value));
+        }
+        this->sample(name, "_sum", labels, std::format("{}", static_cast<double>(histogram.getSum()) / 1e9));
+        this->sample(name, "_count", labels, std::to_string(histogram.getCount()));
+    }
+
+    const std::string &PrometheusWriter::str() const
+    {
+        return this->text_;
+    }
+}   // namespace UNO::COMMON
@@ -0,0 +1,156 @@
+/**
+ * @file Metrics.h
+ *
+ * 无锁的运行指标与 Prometheus 文本格式输出
+ *
+ * 指标只使用 relaxed 原子操作更新，热路径上不加锁；读取方看到的是各个指标近似同一时刻的值
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#pragma once
+#include "LatencyHistogram.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace UNO::COMMON {
+
+    /**
+     * 只增不减的计数器
+     */
+    class Counter {
+    private:
+        std::atomic<uint64_t> value_{0};
+
+    public:
+        void add(uint64_t count = 1);
+
+        [[nodiscard]] uint64_t get() const;
+    };
+
+    /**
+     * 可增可减的瞬时值
+     */
+    class Gauge {
+    private:
+        std::atomic<int64_t> value_{0};
+
+    public:
+        void add(int64_t delta);
+        void set(int64_t value);
+
+        [[nodiscard]] int64_t get() const;
+    };
+
+    /**
+     * 耗时分布，桶的上界固定，从 1 微秒到 100 毫秒
+     */
+    class Histogram {
+    public:
+        /**
+         * 各个桶的上界（纳秒），最后还有一个不设上界的桶
+         */
+        static constexpr std::array<uint64_t, 16> BucketBounds = {1'000,
+                                                                  2'500,
+                                                                  5'000,
+                                                                  10'000,
+                                                                  25'000,
+                                                                  50'000,
+                                                                  100'000,
+                                                                  250'000,
+                                                                  500'000,
+                                                                  1'000'000,
+                                                                  2'500'000,
+                                                                  5'000'000,
+                                                                  10'000'000,
+                                                                  25'000'000,
+                                                                  50'000'000,
+                                                                  100'000'000};
+
+    private:
+        std::array<std::atomic<uint64_t>, BucketBounds.size() + 1> buckets_{};
+        std::atomic<uint64_t> sum_{0};
+
+    public:
+        /**
+         * 记录一次耗时
+         * @param duration 耗时
+         */
+        void observe(std::chrono::nanoseconds duration);
+
+        /**
+         * @param bucket 桶的下标，BucketBounds.size() 为不设上界的桶
+         * @return 落在该桶中的次数（不累计更小的桶）
+         */
+        [[nodiscard]] uint64_t getBucket(size_t bucket) const;
+
+        /**
+         * @return 所有耗时之和（纳秒）
+         */
+        [[nodiscard]] uint64_t getSum() const;
+    };
+
+    /**
+     * 作用域结束时把经过的时间记入直方图
+     */
+    class ScopedTimer {
+    private:
+        Histogram &histogram_;
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        explicit ScopedTimer(Histogram &histogram);
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer &)            = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+    };
+
+    /**
+     * 按 Prometheus 文本格式（0.0.4）输出指标
+     */
+    class PrometheusWriter {
+    private:
+        std::string text_;
+
+        void sample(std::string_view name, std::string_view suffix, std::string_view labels, std::string_view value);
+
+    public:
+        /**
+         * 写出指标族的说明与类型，同一族的样本紧随其后
+         * @param name 指标名
+         * @param help 说明
+         * @param type counter、gauge、histogram 或 summary
+         */
+        void family(std::string_view name, std::string_view help, std::string_view type);
+
+        /**
+         * @param name 指标名
+         * @param labels 不带花括号的标签，例如 type="PLAY_CARD"，可以为空
+         * @param counter 计数器
+         */
+        void write(std::string_view name, std::string_view labels, const Counter &counter);
+        void write(std::string_view name, std::string_view labels, const Gauge &gauge);
+
+        /**
+         * 写出直方图的各个累计桶以及 _sum 和 _count，单位为秒
+         */
+        void write(std::string_view name, std::string_view labels, const Histogram &histogram);
+
+        /**
+         * 以 summary 的形式写出延迟直方图的 p50、p99、p999 以及 _sum 和 _count，单位为秒
+         */
+        void write(std::string_view name, std::string_view labels, const LatencyHistogram &histogram);
+
+        /**
+         * @return 输出的文本
+         */
+        [[nodiscard]] const std::string &str() const;
+    };
+
+}   // namespace UNO::COMMON
@@ -0,0 +1,88 @@
+/**
+ * @file PerfectHash.h
+ *
+ * 编译期构建的字符串完美哈希
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.15
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace UNO::COMMON {
+    /**
+     * 固定字符串集合到下标的完美哈希
+     *
+     * 构造时在编译期搜索一个种子，使所有键落在不同的槽中；查找只需一次哈希、一次比较
+     * @tparam N 键的数量
+     */
+    template<size_t N>
+    class PerfectHash {
+    private:
+        static constexpr size_t TableSize = std::bit_ceil(N * 2);
+        static constexpr uint8_t EmptySlot = 0xFF;
+
+        static_assert(N < EmptySlot, "PerfectHash supports at most 254 keys");
+
+        std::array<std::string_view, N> keys_;
+        std::array<uint8_t, TableSize> slots_;
+        uint32_t seed_;
+
+        static constexpr uint32_t hash(std::string_view key, uint32_t seed)
+        {
+            // 带种子的 FNV-1a
+            uint32_t result = 2166136261U ^ seed;
+            for (char c : key) {
+                result ^= static_cast<uint8_t>(c);
+                result *= 16777619U;
+            }
+            return result ^ (result >> 15);
+        }
+
+        constexpr bool tryBuild(uint32_t seed)
+        {
+            this->slots_.fill(EmptySlot);
+            for (size_t i = 0; i < N; i++) {
+                auto slot = hash(this->keys_[i], seed) & (TableSize - 1);
+                if (this->slots_[slot] != EmptySlot) {
+                    return false;
+                }
+                this->slots_[slot] = static_cast<uint8_t>(i);
+            }
+            this->seed_ = seed;
+            return true;
+        }
+
+    public:
+        /**
+         * @param keys 互不相同的键；找不到可用的种子时编译失败
+         */
+        consteval explicit PerfectHash(const std::array<std::string_view, N> &keys) : keys_(keys), slots_(), seed_(0)
+        {
+            for (uint32_t seed = 0; seed < (1U << 16); seed++) {
+                if (this->tryBuild(seed)) {
+                    return;
+                }
+            }
+            throw "PerfectHash: no collision-free seed found";
+        }
+
+        /**
+         * @param key 要查找的字符串
+         * @return 键在构造时数组中的下标，不存在时为空
+         */
+        [[nodiscard]] constexpr std::optional<size_t> find(std::string_view key) const
+        {
+            auto index = this->slots_[hash(key, this->seed_) & (TableSize - 1)];
+            if (index == EmptySlot || this->keys_[index] != key) {
+                return std::nullopt;
+            }
+            return index;
+        }
+    };
+}   // namespace UNO::COMMON
@@ -0,0 +1,129 @@
+/**
+ * @file Trace.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "Trace.h"
+
+#include <format>
+#include <utility>
+
+namespace UNO::COMMON {
+    TraceBuffer::TraceBuffer(size_t capacity, uint32_t threadId) : capacity_(capacity), recorded_(0), threadId_(threadId)
+    {
+        this->events_.reserve(capacity);
+    }
+
+    void TraceBuffer::push(const TraceEvent &event)
+    {
+        if (this->events_.size() < this->capacity_) {
+            this->events_.push_back(event);
+        }
+        else {
+            this->events_[this->recorded_ % this->events_.size()] = event;
+        }
+        this->recorded_++;
+    }
+
+    std::vector<TraceEvent> TraceBuffer::events() const
+    {
+        if (this->recorded_ <= this->events_.size()) {
+            return this->events_;
+        }
+        // 缓冲区已经绕回，最早的区间在下一个写入位置
+        auto oldest = static_cast<std::ptrdiff_t>(this->recorded_ % this->events_.size());
+        std::vector<TraceEvent> events(this->events_.begin() + oldest, this->events_.end());
+        events.insert(events.end(), this->events_.begin(), this->events_.begin() + oldest);
+        return events;
+    }
+
+    uint32_t TraceBuffer::getThreadId() const
+    {
+        return this->threadId_;
+    }
+
+    std::atomic<bool> Tracer::enabled_{false};
+    std::atomic<uint64_t> Tracer::nextAsyncId_{1};
+    std::mutex Tracer::mutex_;
+    std::vector<std::shared_ptr<TraceBuffer>> Tracer::buffers_;
+    std::chrono::steady_clock::time_point Tracer::origin_;
+
+    TraceBuffer &Tracer::threadBuffer()
+    {
+        // 缓冲区由 buffers_ 共同持有，线程退出后其中的区间仍然可以输出
+        thread_local std::shared_ptr<TraceBuffer> buffer;
+        if (buffer == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer = std::make_shared<TraceBuffer>(RingCapacity, static_cast<uint32_t>(buffers_.size() + 1));
+            buffers_.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void Tracer::enable()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &buffer : buffers_) {
+            *buffer = TraceBuffer(RingCapacity, buffer->getThreadId());
+        }
+        origin_ = std::chrono::steady_clock::now();
+        enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    void Tracer::disable()
+    {
+        enabled_.store(false, std::memory_order_relaxed);
+    }
+
+    uint64_t Tracer::newAsyncId()
+    {
+        return nextAsyncId_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Tracer::record(const char *name,
+                        std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end,
+                        uint64_t asyncId)
+    {
+        threadBuffer().push({name, start, end - start, asyncId});
+    }
+
+    void Tracer::writeChromeTrace(std::ostream &out)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto microseconds = [](std::chrono::steady_clock::duration duration) {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        };
+
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto &buffer : buffers_) {
+            out << std::format(R"({}{{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"uno-{}"}}}})",
+                               first ? "" : ",",
+                               buffer->getThreadId(),
+                               buffer->getThreadId());
+            first = false;
+            for (const auto &event : buffer->events()) {
+                if (event.asyncId != 0) {
+                    // 异步区间按 id 而不是线程配对，开始和结束各输出一个事件
+                    for (auto [phase, time] : {std::pair{'b', event.start}, std::pair{'e', event.start + event.duration}}) {
+                        out << std::format(R"(,{{"name":"{}","cat":"uno","ph":"{}","id":"0x{:x}","ts":{:.3f},"pid":1,"tid":{}}})",
+                                           event.name,
+                                           phase,
+                                           event.asyncId,
+                                           microseconds(time - origin_),
+                                           buffer->getThreadId());
+                    }
+                    continue;
+                }
+                out << std::format(R"(,{{"name":"{}","cat":"uno","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+                                   event.name,
+                                   microseconds(event.start - origin_),
+                                   microseconds(event.duration),
+                                   buffer->getThreadId());
+            }
+        }
+        out << "]}\n";
+    }
+}   // namespace UNO::COMMON
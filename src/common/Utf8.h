@@ -0,0 +1,62 @@
+/**
+ * @file Utf8.h
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.15
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace UNO::COMMON {
+    /**
+     * 检查从 position 开始的 UTF-8 多字节字符，拒绝过长编码、代理区与超出 U+10FFFF 的码点
+     * @param value 字符串
+     * @param position 首字节的位置，首字节不小于 0x80
+     * @return 字符的字节数，不合法时返回 0
+     */
+    constexpr size_t utf8SequenceLength(std::string_view value, size_t position)
+    {
+        auto byteAt         = [&value](size_t i) { return static_cast<uint8_t>(value[i]); };
+        auto isContinuation = [&](size_t i, uint8_t low = 0x80, uint8_t high = 0xBF) {
+            return i < value.size() && byteAt(i) >= low && byteAt(i) <= high;
+        };
+
+        uint8_t lead = byteAt(position);
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            return isContinuation(position + 1) ? 2 : 0;
+        }
+        if (lead >= 0xE0 && lead <= 0xEF) {
+            uint8_t low  = lead == 0xE0 ? 0xA0 : 0x80;
+            uint8_t high = lead == 0xED ? 0x9F : 0xBF;
+            return isContinuation(position + 1, low, high) && isContinuation(position + 2) ? 3 : 0;
+        }
+        if (lead >= 0xF0 && lead <= 0xF4) {
+            uint8_t low  = lead == 0xF0 ? 0x90 : 0x80;
+            uint8_t high = lead == 0xF4 ? 0x8F : 0xBF;
+            return isContinuation(position + 1, low, high) && isContinuation(position + 2) && isContinuation(position + 3) ? 4 : 0;
+        }
+        return 0;
+    }
+
+    /**
+     * @param value 字符串
+     * @return 整个字符串是否为合法的 UTF-8，规则与 utf8SequenceLength 相同
+     */
+    constexpr bool isValidUtf8(std::string_view value)
+    {
+        for (size_t i = 0; i < value.size();) {
+            if (static_cast<uint8_t>(value[i]) < 0x80) {
+                i++;
+                continue;
+            }
+            size_t length = utf8SequenceLength(value, i);
+            if (length == 0) {
+                return false;
+            }
+            i += length;
+        }
+        return true;
+    }
+}   // namespace UNO::COMMON
@@ -11,6 +11,9 @@ namespace UNO::COMMON {
     std::mt19937 &Random::getGenerator() {
         return gen_;
     }
+    void Random::seed(std::mt19937::result_type seed) {
+        gen_.seed(seed);
+    }
 
     Utils* Utils::instance_ = nullptr;
 
@@ -25,6 +25,12 @@ namespace UNO::COMMON {
          * @return 一个 std::mt19937
          */
         std::mt19937 &getGenerator();
+
+        /**
+         * 使用固定的种子，使之后的洗牌结果可以复现
+         * @param seed 种子
+         */
+        void seed(std::mt19937::result_type seed);
     };
 
     class Utils {
@@ -77,6 +77,14 @@ namespace UNO::GAME {
         return this->front();
     }
 
+    DiscardSummary DiscardPile::getSummary() const
+    {
+        if (this->isEmpty()) {
+            return {std::nullopt, 0};
+        }
+        return {this->front(), this->getCards().size()};
+    }
+
     Deck::Deck()
     {
         this->init();
@@ -9,6 +9,7 @@
 #ifndef UNO_GAME_CARDTILE_H
 #define UNO_GAME_CARDTILE_H
 #include <deque>
+#include <optional>
 #include <vector>
 
 #include "Card.h"
@@ -74,6 +75,19 @@ namespace UNO::GAME {
         void clear();
     };
 
+    /**
+     * @brief 弃牌堆的摘要：客户端只需要最上方的牌和牌数
+     *
+     * 打出的万能牌带有玩家选择的颜色，因此最上方的牌的颜色就是当前的有效颜色
+     */
+    struct DiscardSummary {
+        /**
+         * 最上方的牌，牌堆为空时没有值
+         */
+        std::optional<Card> top;
+        size_t size;
+    };
+
     /**
      * @brief 弃牌堆
      */
@@ -90,6 +104,11 @@ namespace UNO::GAME {
          * @return 牌堆中最上方的牌
          */
         [[nodiscard]] Card getFront() const;
+
+        /**
+         * @return 弃牌堆的摘要
+         */
+        [[nodiscard]] DiscardSummary getSummary() const;
     };
 
     /**
@@ -6,6 +6,8 @@
  */
 #include "GameState.h"
 
+#include "../common/Utils.h"
+
 #include <ranges>
 #include <stdexcept>
 #include <utility>
@@ -84,6 +86,11 @@ namespace UNO::GAME {
         return PlayerState::play(card);
     }
 
+    bool ServerPlayerState::hasCard(const Card &card) const
+    {
+        return this->handCard_.contains(card);
+    }
+
     bool ServerPlayerState::isEmpty() const
     {
         return this->handCard_.isEmpty();
@@ -95,7 +102,7 @@ namespace UNO::GAME {
         this->handCard_.clear();
     }
 
-    ClientGameState::ClientGameState() : clientGameStage_(ClientGameStage::PENDING_CONNECTION) {}
+    ClientGameState::ClientGameState() : clientGameStage_(ClientGameStage::PENDING_CONNECTION), discardPileSize_(0) {}
 
     std::string ClientGameState::getPlayerName() const
     {
@@ -128,15 +135,16 @@ namespace UNO::GAME {
         return this->player_.getCards();
     }
 
-    void ClientGameState::init(const std::vector<ClientPlayerState> &players,
-                               const DiscardPile &discardPile,
-                               const std::multiset<Card> &handCard,
+    void ClientGameState::init(std::vector<ClientPlayerState> players,
+                               DiscardPile discardPile,
+                               std::multiset<Card> handCard,
                                const size_t &currentPlayerIndex,
                                const size_t &selfIndex)
     {
-        this->players_     = players;
-        this->discardPile_ = discardPile;
-        player_.draw(std::vector<Card>(handCard.begin(), handCard.end()));
+        this->players_         = std::move(players);
+        this->discardPileSize_ = discardPile.getCards().size();
+        this->discardPile_     = std::move(discardPile);
+        player_.draw(std::move(handCard));
         this->currentPlayer_ = this->players_.begin() + static_cast<int>(currentPlayerIndex);
         this->self_          = this->players_.begin() + static_cast<int>(selfIndex);
         if (this->self_ == this->currentPlayer_) {
@@ -147,6 +155,34 @@ namespace UNO::GAME {
         }
     }
 
+    void ClientGameState::init(std::vector<ClientPlayerState> players,
+                               const DiscardSummary &discardSummary,
+                               std::multiset<Card> handCard,
+                               const size_t &currentPlayerIndex,
+                               const size_t &selfIndex)
+    {
+        DiscardPile discardPile;
+        if (discardSummary.top.has_value()) {
+            discardPile.add(*discardSummary.top);
+        }
+        this->init(std::move(players), std::move(discardPile), std::move(handCard), currentPlayerIndex, selfIndex);
+        this->discardPileSize_ = discardSummary.size;
+    }
+
+    void ClientGameState::sync(std::vector<ClientPlayerState> players,
+                               const DiscardSummary &discardSummary,
+                               std::multiset<Card> handCard,
+                               const size_t &currentPlayerIndex,
+                               const size_t &selfIndex,
+                               bool isReversed,
+                               size_t drawCount)
+    {
+        this->player_.clear();
+        this->init(std::move(players), discardSummary, std::move(handCard), currentPlayerIndex, selfIndex);
+        this->isReversed_ = isReversed;
+        this->drawCount_  = drawCount;
+    }
+
     void ClientGameState::draw(const Card &card)
     {
         this->player_.draw(card);
@@ -167,6 +203,20 @@ namespace UNO::GAME {
         return this->player_.isEmpty();
     }
 
+    void ClientGameState::updateStateByCard(const Card &card)
+    {
+        GameState::updateStateByCard(card);
+        this->discardPileSize_++;
+    }
+
+    DiscardSummary ClientGameState::getDiscardSummary() const
+    {
+        if (this->discardPile_.isEmpty()) {
+            return {std::nullopt, this->discardPileSize_};
+        }
+        return {this->discardPile_.getFront(), this->discardPileSize_};
+    }
+
     void ClientGameState::setClientGameStageConnected()
     {
         this->clientGameStage_ = ClientGameStage::PRE_GAME;
@@ -194,6 +244,16 @@ namespace UNO::GAME {
 
     void ServerGameState::init()
     {
+        this->init(COMMON::Utils::getInstance()->getRandom().getGenerator()());
+    }
+
+    void ServerGameState::init(std::mt19937::result_type seed)
+    {
+        // 牌堆只在开局时按种子重新洗牌，一局中途牌堆耗尽时的重新洗牌也由同一个生成器决定
+        COMMON::Utils::getInstance()->getRandom().seed(seed);
+        this->deck_.clear();
+        this->deck_.init();
+
         while (discardPile_.isEmpty() || discardPile_.getFront().getType() > CardType::NUM9) {
             discardPile_.add(deck_.draw());
         }
@@ -9,6 +9,7 @@
 #include "CardTile.h"
 #include "Player.h"
 
+#include <random>
 #include <stdexcept>
 #include <string>
 
@@ -113,6 +114,12 @@ namespace UNO::GAME {
          */
         Card play(const Card &card) override;
 
+        /**
+         * @param card 要打出的牌
+         * @return 手牌中是否有这张牌
+         */
+        [[nodiscard]] bool hasCard(const Card &card) const;
+
         /**
          * @return 手牌是否为空
          */
@@ -180,6 +187,13 @@ namespace UNO::GAME {
          */
         void clearPlayers();
 
+        /**
+         * 只检查弃牌堆顶与累计的摸牌数，不检查手牌
+         * @param card 要打出的牌
+         * @return 这张牌能否打出
+         */
+        [[nodiscard]] bool canPlay(const Card &card) const;
+
         /**
          * 由于用户出牌而改变状态
          * @param card 用户出的牌
@@ -259,10 +273,16 @@ namespace UNO::GAME {
         this->isReversed_ ^= 1;
     }
 
+    template<PlayerStateTypeConcept PlayerStateType>
+    bool GameState<PlayerStateType>::canPlay(const Card &card) const
+    {
+        return this->discardPile_.isEmpty() || card.canBePlayedOn(this->discardPile_.getFront(), this->drawCount_);
+    }
+
     template<PlayerStateTypeConcept PlayerStateType>
     void GameState<PlayerStateType>::updateStateByCard(const Card &card)
     {
-        if (this->discardPile_.isEmpty() == false && card.canBePlayedOn(this->discardPile_.getFront(), this->drawCount_) == false) {
+        if (this->canPlay(card) == false) {
             throw std::invalid_argument("Card cannot be played");
         }
         this->currentPlayer_->play(card);
@@ -312,6 +332,11 @@ namespace UNO::GAME {
         std::vector<ClientPlayerState>::const_iterator self_;
         ClientGameStage clientGameStage_;
 
+        /**
+         * 服务端弃牌堆的牌数；客户端只保存开局后看到的牌，不保存完整的弃牌堆
+         */
+        size_t discardPileSize_;
+
     private:
         void nextPlayer() override;
 
@@ -342,14 +367,34 @@ namespace UNO::GAME {
         [[nodiscard]] const std::multiset<Card> &getCards() const;
 
         /**
-         * 初始化客户端状态
+         * 初始化客户端状态，参数按值传入，调用方可以移入以避免复制
          */
-        void init(const std::vector<ClientPlayerState> &players,
-                  const DiscardPile &discardPile,
-                  const std::multiset<Card> &handCard,
+        void init(std::vector<ClientPlayerState> players,
+                  DiscardPile discardPile,
+                  std::multiset<Card> handCard,
                   const size_t &currentPlayerIndex,
                   const size_t &selfIndex);
 
+        /**
+         * 用弃牌堆的摘要初始化客户端状态，弃牌堆只保留最上方的牌
+         */
+        void init(std::vector<ClientPlayerState> players,
+                  const DiscardSummary &discardSummary,
+                  std::multiset<Card> handCard,
+                  const size_t &currentPlayerIndex,
+                  const size_t &selfIndex);
+
+        /**
+         * 用服务端的快照替换客户端状态，弃牌堆只保留最上方的牌
+         */
+        void sync(std::vector<ClientPlayerState> players,
+                  const DiscardSummary &discardSummary,
+                  std::multiset<Card> handCard,
+                  const size_t &currentPlayerIndex,
+                  const size_t &selfIndex,
+                  bool isReversed,
+                  size_t drawCount);
+
         /**
          * 摸一张牌
          * @param card 摸的牌
@@ -373,6 +418,13 @@ namespace UNO::GAME {
          */
         [[nodiscard]] bool isEmpty() const;
 
+        void updateStateByCard(const Card &card) override;
+
+        /**
+         * @return 弃牌堆的摘要，牌数与服务端一致
+         */
+        [[nodiscard]] DiscardSummary getDiscardSummary() const;
+
         /**
          * 获取游戏阶段
          * @return 游戏阶段
@@ -401,10 +453,16 @@ namespace UNO::GAME {
         ServerGameState();
 
         /**
-         * 开始游戏
+         * 开始游戏，种子取自全局的随机数生成器
          */
         void init();
 
+        /**
+         * 用给定的种子重新洗牌后开始游戏；此前的操作与种子都相同时，发牌与之后的每次摸牌都相同
+         * @param seed 洗牌使用的种子
+         */
+        void init(std::mt19937::result_type seed);
+
         /**
          * 向对局中添加玩家
          * @param playerState 要添加的玩家状态
@@ -29,24 +29,40 @@ namespace UNO::GAME {
         }
     }
 
-    void HandCard::play(const std::multiset<Card>::iterator &it)
+    void HandCard::draw(std::multiset<Card> &&cards)
+    {
+        this->cards_.merge(cards);
+    }
+
+    void HandCard::play(std::multiset<Card>::const_iterator it)
     {
         this->cards_.erase(it);
     }
 
 
-    void HandCard::play(const Card &card)
+    std::multiset<Card>::const_iterator HandCard::find(const Card &card) const
     {
-        for (auto it = cards_.begin();; it++) {
-            if (it == cards_.end()) {
-                throw std::invalid_argument("Card not found in hand");
-            }
+        for (auto it = cards_.begin(); it != cards_.end(); it++) {
             if (card.getType() == it->getType()
                 && (card.getType() == CardType::WILD || card.getType() == CardType::WILDDRAWFOUR || card.getColor() == it->getColor())) {
-                this->play(it);
-                break;
+                return it;
             }
         }
+        return cards_.end();
+    }
+
+    void HandCard::play(const Card &card)
+    {
+        auto it = this->find(card);
+        if (it == cards_.end()) {
+            throw std::invalid_argument("Card not found in hand");
+        }
+        this->play(it);
+    }
+
+    bool HandCard::contains(const Card &card) const
+    {
+        return this->find(card) != cards_.end();
     }
 
     bool HandCard::isEmpty() const
@@ -87,6 +103,11 @@ namespace UNO::GAME {
         this->handCard_.draw(cards);
     }
 
+    void Player::draw(std::multiset<Card> &&cards)
+    {
+        this->handCard_.draw(std::move(cards));
+    }
+
     bool Player::isEmpty() const
     {
         return this->handCard_.isEmpty();
@@ -26,7 +26,14 @@ namespace UNO::GAME {
          * 打出一张牌
          * @param it 要打出的手牌的迭代器
          */
-        void play(const std::multiset<Card>::iterator &it);
+        void play(std::multiset<Card>::const_iterator it);
+
+        /**
+         * 查找与 card 匹配的手牌，万能牌只比较类型
+         * @param card 要查找的牌
+         * @return 匹配的手牌的迭代器，没有时为 end()
+         */
+        [[nodiscard]] std::multiset<Card>::const_iterator find(const Card &card) const;
 
     public:
         explicit HandCard();
@@ -49,12 +56,24 @@ namespace UNO::GAME {
          */
         void draw(const std::vector<Card> &cards);
 
+        /**
+         * 摸多张牌，直接接管 cards 中的节点而不复制
+         * @param cards 摸的牌
+         */
+        void draw(std::multiset<Card> &&cards);
+
         /**
          * 打出一张牌
          * @param card 要打出的手牌
          */
         void play(const Card &card);
 
+        /**
+         * @param card 要打出的牌
+         * @return 手牌中是否有可以作为 card 打出的牌
+         */
+        [[nodiscard]] bool contains(const Card &card) const;
+
         /**
          * @return 手牌是否为空
          */
@@ -102,6 +121,12 @@ namespace UNO::GAME {
          */
         void draw(const std::vector<Card> &cards);
 
+        /**
+         * 摸多张牌，直接接管 cards 中的节点而不复制
+         * @param cards 摸的牌
+         */
+        void draw(std::multiset<Card> &&cards);
+
         /**
          * 打出一张牌
          * @param card 要打出的手牌
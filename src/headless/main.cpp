@@ -0,0 +1,62 @@
+/**
+ * @file main.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include <argparse/argparse.hpp>
+
+#include "../client/HeadlessClient.h"
+
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("Uno Headless Client", "0.1.0");
+
+    parser.add_argument("--host").help("server address").default_value(std::string("127.0.0.1"));
+    parser.add_argument("-p", "--port").help("server port").default_value(static_cast<uint16_t>(10001)).scan<'i', uint16_t>();
+    parser.add_argument("--name").help("player name").default_value(std::string("bot"));
+    parser.add_argument("--games")
+        .help("games to play before exiting, 0 plays forever")
+        .default_value(0ull)
+        .scan<'u', unsigned long long>();
+    parser.add_argument("--ready-delay")
+        .help("milliseconds to wait after joining before readying the first game")
+        .default_value(1000u)
+        .scan<'u', unsigned>();
+    parser.add_argument("--json").help("encode messages as JSON instead of binary").default_value(false).implicit_value(true);
+
+    try {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    try {
+        UNO::CLIENT::HeadlessOptions options;
+        options.name       = parser.get<std::string>("--name");
+        options.host       = parser.get<std::string>("--host");
+        options.port       = parser.get<uint16_t>("--port");
+        options.encoding   = parser.get<bool>("--json") ? UNO::NETWORK::MessageEncoding::JSON : UNO::NETWORK::MessageEncoding::BINARY;
+        options.games      = parser.get<unsigned long long>("--games");
+        options.readyDelay = std::chrono::milliseconds(parser.get<unsigned>("--ready-delay"));
+
+        UNO::CLIENT::HeadlessClient client(options);
+        bool is_completed = client.run();
+        std::cout << "games: " << client.getGamesEnded() << ", rejected: " << client.getRejected() << std::endl;
+        if (is_completed == false) {
+            std::cerr << "gave up connecting to the server" << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
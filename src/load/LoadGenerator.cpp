@@ -0,0 +1,205 @@
+/**
+ * @file LoadGenerator.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#include "LoadGenerator.h"
+
+#include "LoadPlayer.h"
+
+#include <algorithm>
+#include <format>
+#include <future>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace UNO::LOAD {
+    namespace {
+        /**
+         * 同一房间的玩家都在同一个 io_context 上，房间的状态不需要加锁
+         */
+        struct Room {
+            asio::io_context *io_context;
+            std::vector<std::unique_ptr<LoadPlayer>> players;
+            size_t joined = 0;
+        };
+
+        long peakRssKib()
+        {
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            return usage.ru_maxrss;
+        }
+    }   // namespace
+
+    std::string LoadReport::toJson() const
+    {
+        auto microseconds = [](std::chrono::nanoseconds latency) { return std::chrono::duration<double, std::micro>(latency).count(); };
+        return std::format(R"({{"seconds":{:.3f},"connected":{},"connect_failed":{},"disconnected":{},"joined":{},"games":{},)"
+                           R"("games_per_second":{:.1f},"messages":{},"messages_per_second":{:.1f},"rejected":{},)"
+                           R"("turn_latency_us":{{"p50":{:.1f},"p99":{:.1f},"p999":{:.1f}}},"peak_rss_kib":{}}})",
+                           this->seconds,
+                           this->connected,
+                           this->connectFailed,
+                           this->disconnected,
+                           this->joined,
+                           this->games,
+                           this->gamesPerSecond,
+                           this->messages,
+                           this->messagesPerSecond,
+                           this->rejected,
+                           microseconds(this->turnLatencyP50),
+                           microseconds(this->turnLatencyP99),
+                           microseconds(this->turnLatencyP999),
+                           this->peakRssKib);
+    }
+
+    LoadGenerator::LoadGenerator(const LoadConfig &config) : config_(config) {}
+
+    LoadReport LoadGenerator::run(const std::function<void(const LoadReport &)> &onProgress)
+    {
+        if (this->config_.roomSize < 2) {
+            throw std::invalid_argument("A room needs at least two players");
+        }
+        if (this->config_.threads == 0 || this->config_.joinRate <= 0) {
+            throw std::invalid_argument("Threads and join rate must be positive");
+        }
+        if (this->config_.rooms > 0 && this->config_.port + (this->config_.rooms - 1) > std::numeric_limits<uint16_t>::max()) {
+            throw std::invalid_argument("Room ports run past 65535");
+        }
+
+        asio::io_context resolver_context;
+        asio::ip::tcp::resolver resolver(resolver_context);
+        auto address = resolver.resolve(this->config_.host, "")->endpoint().address();
+
+        // io_context 必须在玩家之后析构：挂起的协程持有 Session
+        std::vector<std::unique_ptr<asio::io_context>> contexts;
+        std::vector<asio::executor_work_guard<asio::io_context::executor_type>> workGuards;
+        for (size_t i = 0; i < this->config_.threads; i++) {
+            contexts.push_back(std::make_unique<asio::io_context>(1));
+            workGuards.push_back(asio::make_work_guard(*contexts.back()));
+        }
+
+        LoadStats stats;
+        std::vector<Room> rooms(this->config_.rooms);
+        for (size_t i = 0; i < rooms.size(); i++) {
+            auto &room      = rooms[i];
+            room.io_context = contexts[i % contexts.size()].get();
+            asio::ip::tcp::endpoint endpoint(address, static_cast<uint16_t>(this->config_.port + i));
+            for (size_t j = 0; j < this->config_.roomSize; j++) {
+                // 房间坐满之后所有玩家一起准备，否则先准备好的玩家会在其他玩家加入之前开局
+                room.players.push_back(std::make_unique<LoadPlayer>(*room.io_context,
+                                                                    endpoint,
+                                                                    std::format("load{}-{}", i, j),
+                                                                    this->config_.encoding,
+                                                                    this->config_.thinkTime,
+                                                                    stats,
+                                                                    [&room]() {
+                                                                        if (++room.joined == room.players.size()) {
+                                                                            for (auto &player : room.players) {
+                                                                                player->ready();
+                                                                            }
+                                                                        }
+                                                                    }));
+            }
+        }
+
+        std::vector<std::thread> threads;
+        for (auto &context : contexts) {
+            threads.emplace_back([&context]() { context->run(); });
+        }
+
+        auto snapshot = [&stats, this](double seconds) -> LoadReport {
+            return {seconds,
+                    stats.connected.get(),
+                    stats.connectFailed.get(),
+                    stats.disconnected.get(),
+                    stats.joined.get(),
+                    stats.gamesEnded.get() / this->config_.roomSize,
+                    stats.messagesSent.get() + stats.messagesReceived.get(),
+                    stats.messagesRejected.get(),
+                    0,
+                    0,
+                    stats.turnLatency.percentile(0.5),
+                    stats.turnLatency.percentile(0.99),
+                    stats.turnLatency.percentile(0.999),
+                    peakRssKib()};
+        };
+
+        // 按 joinRate 逐个发起连接，期间照常报告进度；先坐满前面的房间，使对局尽早开始
+        auto start      = std::chrono::steady_clock::now();
+        auto end        = start + this->config_.duration;
+        auto nextReport = start + this->config_.reportInterval;
+        auto joinTime   = [start, this](size_t player) {
+            return start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<double>(static_cast<double>(player) / this->config_.joinRate));
+        };
+        size_t total    = this->config_.rooms * this->config_.roomSize;
+        size_t started  = 0;
+        LoadReport last = snapshot(0);
+        while (true) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= end) {
+                break;
+            }
+            while (started < total && joinTime(started) <= now) {
+                auto &room   = rooms[started / this->config_.roomSize];
+                auto *player = room.players[started % this->config_.roomSize].get();
+                asio::post(*room.io_context, [player]() { player->connect(); });
+                started++;
+            }
+            if (now >= nextReport) {
+                auto report              = snapshot(std::chrono::duration<double>(now - start).count());
+                auto interval            = report.seconds - last.seconds;
+                report.gamesPerSecond    = static_cast<double>(report.games - last.games) / interval;
+                report.messagesPerSecond = static_cast<double>(report.messages - last.messages) / interval;
+                if (onProgress) {
+                    onProgress(report);
+                }
+                last = report;
+                nextReport += this->config_.reportInterval;
+            }
+
+            auto wake = std::min(end, nextReport);
+            if (started < total) {
+                wake = std::min(wake, joinTime(started));
+            }
+            std::this_thread::sleep_until(wake);
+        }
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // 玩家只能在自己的 io_context 上停止；每个 io_context 依次执行投递的任务，屏障完成时其上的玩家都已停止
+        std::vector<std::future<void>> barriers;
+        for (auto &room : rooms) {
+            asio::post(*room.io_context, [&room]() {
+                for (auto &player : room.players) {
+                    player->stop();
+                }
+            });
+        }
+        for (auto &context : contexts) {
+            auto barrier = std::make_shared<std::promise<void>>();
+            barriers.push_back(barrier->get_future());
+            asio::post(*context, [barrier]() { barrier->set_value(); });
+        }
+        for (auto &barrier : barriers) {
+            barrier.wait();
+        }
+        for (auto &context : contexts) {
+            context->stop();
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        auto report              = snapshot(seconds);
+        report.gamesPerSecond    = static_cast<double>(report.games) / seconds;
+        report.messagesPerSecond = static_cast<double>(report.messages) / seconds;
+        return report;
+    }
+}   // namespace UNO::LOAD
@@ -0,0 +1,124 @@
+/**
+ * @file LoadGenerator.h
+ *
+ * 在一个进程中模拟大量玩家：所有玩家共享少量 io_context 线程，而不是每名玩家一个 NetworkClient 线程
+ *
+ * 一个服务端进程只有一局游戏，因此每个房间对应一个服务端，端口从 port 开始依次递增
+ *
+ * 每名玩家占用一个文件描述符，玩家数的上限通常是 RLIMIT_NOFILE 的硬限制；
+ * 每名玩家的常驻内存约 8 KiB（2 个线程、9600 名玩家时峰值 72 MiB）
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#pragma once
+#include "../network/MessageSerializer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace UNO::LOAD {
+
+    struct LoadConfig {
+        std::string host = "127.0.0.1";
+
+        /**
+         * 第一个房间的服务端端口，第 i 个房间连接 port + i，最后一个房间的端口不能超过 65535
+         */
+        uint16_t port = 10001;
+
+        size_t rooms = 1;
+
+        /**
+         * 每个房间的玩家数，房间坐满后开始第一局
+         */
+        size_t roomSize = 4;
+
+        /**
+         * 每秒发起的连接数
+         */
+        double joinRate = 1000;
+
+        /**
+         * 每次行动前的等待时间，为 0 时立即行动
+         */
+        std::chrono::milliseconds thinkTime{0};
+
+        /**
+         * 网络线程数，每个线程运行一个 io_context
+         */
+        size_t threads = 1;
+
+        /**
+         * 从开始连接到停止的总时长
+         */
+        std::chrono::milliseconds duration = std::chrono::seconds(60);
+
+        /**
+         * 报告进度的间隔
+         */
+        std::chrono::milliseconds reportInterval = std::chrono::seconds(1);
+
+        NETWORK::MessageEncoding encoding = NETWORK::MessageEncoding::BINARY;
+    };
+
+    struct LoadReport {
+        double seconds;
+        uint64_t connected;
+        uint64_t connectFailed;
+        uint64_t disconnected;
+        uint64_t joined;
+        uint64_t games;
+
+        /**
+         * 所有玩家收发的消息总数
+         */
+        uint64_t messages;
+
+        /**
+         * 被服务端拒绝的消息数，只在最终报告中有值
+         */
+        uint64_t rejected;
+
+        /**
+         * 进度报告中为最近一个间隔内的速率，最终报告中为整个运行期间的平均速率
+         */
+        double gamesPerSecond;
+        double messagesPerSecond;
+
+        /**
+         * 从开始运行累计的回合延迟
+         */
+        std::chrono::nanoseconds turnLatencyP50;
+        std::chrono::nanoseconds turnLatencyP99;
+        std::chrono::nanoseconds turnLatencyP999;
+
+        /**
+         * 整个进程的峰值常驻内存，单位为 KiB
+         */
+        long peakRssKib;
+
+        /**
+         * @return 一行 JSON
+         */
+        [[nodiscard]] std::string toJson() const;
+    };
+
+    class LoadGenerator {
+    private:
+        LoadConfig config_;
+
+    public:
+        explicit LoadGenerator(const LoadConfig &config);
+
+        /**
+         * 运行负载，阻塞直到达到配置的时长
+         * @param onProgress 每隔 reportInterval 在调用线程上调用一次，可以为空
+         * @return 最终报告
+         */
+        LoadReport run(const std::function<void(const LoadReport &)> &onProgress = {});
+    };
+
+}   // namespace UNO::LOAD
@@ -0,0 +1,120 @@
+/**
+ * @file LoadPlayer.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#include "LoadPlayer.h"
+
+#include <utility>
+
+namespace UNO::LOAD {
+    LoadPlayer::LoadPlayer(asio::io_context &io_context,
+                           asio::ip::tcp::endpoint endpoint,
+                           const std::string &name,
+                           NETWORK::MessageEncoding encoding,
+                           std::chrono::milliseconds thinkTime,
+                           LoadStats &stats,
+                           std::function<void()> onJoined) :
+        io_context_(io_context),
+        endpoint_(std::move(endpoint)),
+        core_(encoding,
+              [this](std::shared_ptr<const std::string> message) {
+                  this->session_->send(std::move(message));
+                  this->stats_.messagesSent.add();
+              },
+              *this),
+        stats_(stats),
+        onJoined_(std::move(onJoined)),
+        hasReportedJoin_(false),
+        thinkTime_(thinkTime),
+        thinkTimer_(io_context),
+        isThinking_(false),
+        isWaiting_(false),
+        gamesEnded_(0)
+    {
+        this->core_.setPlayerName(name);
+    }
+
+    void LoadPlayer::connect()
+    {
+        auto socket = std::make_shared<asio::ip::tcp::socket>(this->io_context_);
+        socket->async_connect(this->endpoint_, [this, socket](const asio::error_code &ec) {
+            if (ec) {
+                this->stats_.connectFailed.add();
+                return;
+            }
+            this->stats_.connected.add();
+            this->session_ = std::make_shared<NETWORK::Session>(std::move(*socket));
+            this->session_->start(
+                [this](std::string message) {
+                    this->stats_.messagesReceived.add();
+                    this->core_.handleMessage(message);
+                },
+                [this]() { this->stats_.disconnected.add(); });
+            this->core_.handleConnected();
+        });
+    }
+
+    void LoadPlayer::ready()
+    {
+        this->core_.ready();
+    }
+
+    void LoadPlayer::stop()
+    {
+        this->thinkTimer_.cancel();
+        if (this->session_ != nullptr) {
+            this->session_->close();
+        }
+        this->stats_.messagesRejected.add(this->core_.getRejected());
+    }
+
+    void LoadPlayer::act()
+    {
+        this->bot_.onUpdate(this->core_);
+        if (this->isWaiting_ == false && this->core_.isWaiting()) {
+            this->actionTime_ = std::chrono::steady_clock::now();
+        }
+        this->isWaiting_ = this->core_.isWaiting();
+    }
+
+    void LoadPlayer::onUpdate(CLIENT::ClientCore &core)
+    {
+        if (this->hasReportedJoin_ == false && core.hasJoined()) {
+            this->hasReportedJoin_ = true;
+            this->stats_.joined.add();
+            this->onJoined_();
+        }
+        if (core.getGamesEnded() != this->gamesEnded_) {
+            this->stats_.gamesEnded.add(core.getGamesEnded() - this->gamesEnded_);
+            this->gamesEnded_ = core.getGamesEnded();
+        }
+
+        // 自己的出牌或摸牌被广播回来，这一回合结束
+        if (this->isWaiting_ && core.isWaiting() == false) {
+            this->stats_.turnLatency.record(std::chrono::steady_clock::now() - this->actionTime_);
+            this->isWaiting_ = false;
+        }
+
+        if (this->thinkTime_.count() == 0) {
+            this->act();
+            return;
+        }
+        // 只有轮到自己或者一局结束后才需要决策
+        auto stage = core.getGameState()->getClientGameStage();
+        if (this->isThinking_ || core.isWaiting()
+            || (stage != GAME::ClientGameStage::ACTIVE && stage != GAME::ClientGameStage::AFTER_GAME)) {
+            return;
+        }
+        this->isThinking_ = true;
+        this->thinkTimer_.expires_after(this->thinkTime_);
+        this->thinkTimer_.async_wait([this](const asio::error_code &ec) {
+            if (ec) {
+                return;
+            }
+            this->isThinking_ = false;
+            this->act();
+        });
+    }
+}   // namespace UNO::LOAD
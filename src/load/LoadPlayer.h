@@ -0,0 +1,117 @@
+/**
+ * @file LoadPlayer.h
+ *
+ * 负载生成器中的一名玩家：不拥有线程，与同一 io_context 上的其他玩家共享网络线程
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#pragma once
+#include "../client/BotPolicy.h"
+#include "../client/ClientCore.h"
+#include "../common/Metrics.h"
+#include "../network/Session.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace UNO::LOAD {
+
+    /**
+     * 所有玩家共享的统计，可以在任意线程上更新与读取
+     */
+    struct LoadStats {
+        COMMON::Counter connected;
+        COMMON::Counter connectFailed;
+        COMMON::Counter disconnected;
+        COMMON::Counter joined;
+        COMMON::Counter messagesSent;
+        COMMON::Counter messagesReceived;
+
+        /**
+         * 每名玩家各记一次
+         */
+        COMMON::Counter gamesEnded;
+
+        /**
+         * 被服务端拒绝的消息数，玩家停止时才计入
+         */
+        COMMON::Counter messagesRejected;
+
+        /**
+         * 从发出出牌或摸牌到收到服务端对应广播的时间，不含思考时间
+         */
+        COMMON::LatencyHistogram turnLatency;
+    };
+
+    class LoadPlayer : public CLIENT::ClientPolicy {
+    private:
+        asio::io_context &io_context_;
+        asio::ip::tcp::endpoint endpoint_;
+        std::shared_ptr<NETWORK::Session> session_;
+        CLIENT::ClientCore core_;
+        CLIENT::BotPolicy bot_;
+        LoadStats &stats_;
+
+        /**
+         * 入座后调用一次，在玩家的 io_context 上执行
+         */
+        std::function<void()> onJoined_;
+        bool hasReportedJoin_;
+
+        /**
+         * 轮到自己后等待思考时间再交给 BotPolicy，等待期间到达的消息不再重复计时
+         */
+        std::chrono::milliseconds thinkTime_;
+        asio::steady_timer thinkTimer_;
+        bool isThinking_;
+
+        bool isWaiting_;
+        std::chrono::steady_clock::time_point actionTime_;
+        uint64_t gamesEnded_;
+
+    private:
+        /**
+         * 交给 BotPolicy 决策，并记录出牌或摸牌的时刻
+         */
+        void act();
+
+    public:
+        /**
+         * @param io_context 玩家所在的 io_context，同一房间的玩家必须使用同一个
+         * @param endpoint 服务端地址
+         * @param name 玩家名字
+         * @param encoding 使用的编码
+         * @param thinkTime 每次行动前的等待时间
+         * @param stats 共享的统计
+         * @param onJoined 入座后调用
+         */
+        LoadPlayer(asio::io_context &io_context,
+                   asio::ip::tcp::endpoint endpoint,
+                   const std::string &name,
+                   NETWORK::MessageEncoding encoding,
+                   std::chrono::milliseconds thinkTime,
+                   LoadStats &stats,
+                   std::function<void()> onJoined);
+
+        /**
+         * 连接服务端并加入游戏，必须在玩家的 io_context 上调用
+         */
+        void connect();
+
+        /**
+         * 准备开始第一局；之后每局结束后 BotPolicy 会自动再次准备
+         */
+        void ready();
+
+        /**
+         * 断开连接并把被拒绝的消息数计入统计，必须在玩家的 io_context 上调用
+         */
+        void stop();
+
+        void onUpdate(CLIENT::ClientCore &core) override;
+    };
+
+}   // namespace UNO::LOAD
@@ -0,0 +1,78 @@
+/**
+ * @file main.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#include <argparse/argparse.hpp>
+
+#include "LoadGenerator.h"
+
+#include <iostream>
+#include <sys/resource.h>
+#include <thread>
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("Uno Load Generator", "0.1.0");
+
+    parser.add_argument("--host").help("server address").default_value(std::string("127.0.0.1"));
+    parser.add_argument("-p", "--port")
+        .help("port of the first room's server, room i connects to port + i")
+        .default_value(static_cast<uint16_t>(10001))
+        .scan<'i', uint16_t>();
+    parser.add_argument("-r", "--rooms").help("rooms, one uno-server each").default_value(static_cast<size_t>(1)).scan<'u', size_t>();
+    parser.add_argument("--room-size").help("players per room").default_value(static_cast<size_t>(4)).scan<'u', size_t>();
+    parser.add_argument("--join-rate").help("connections opened per second").default_value(1000.0).scan<'g', double>();
+    parser.add_argument("--think-time").help("milliseconds to wait before each move").default_value(0u).scan<'u', unsigned>();
+    parser.add_argument("-t", "--threads")
+        .help("network threads shared by all players")
+        .default_value(static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())))
+        .scan<'u', size_t>();
+    parser.add_argument("-d", "--duration").help("seconds to run, including the join phase").default_value(60.0).scan<'g', double>();
+    parser.add_argument("--report-interval").help("seconds between progress lines").default_value(1.0).scan<'g', double>();
+    parser.add_argument("--json").help("encode messages as JSON instead of binary").default_value(false).implicit_value(true);
+
+    try {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    try {
+        UNO::LOAD::LoadConfig config;
+        config.host           = parser.get<std::string>("--host");
+        config.port           = parser.get<uint16_t>("--port");
+        config.rooms          = parser.get<size_t>("--rooms");
+        config.roomSize       = parser.get<size_t>("--room-size");
+        config.joinRate       = parser.get<double>("--join-rate");
+        config.thinkTime      = std::chrono::milliseconds(parser.get<unsigned>("--think-time"));
+        config.threads        = parser.get<size_t>("--threads");
+        config.duration       = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::duration<double>(parser.get<double>("--duration")));
+        config.reportInterval = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::duration<double>(parser.get<double>("--report-interval")));
+        config.encoding       = parser.get<bool>("--json") ? UNO::NETWORK::MessageEncoding::JSON : UNO::NETWORK::MessageEncoding::BINARY;
+
+        // 每名玩家占用一个文件描述符，默认的软限制通常只有 1024
+        rlimit limit{};
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+
+        auto report = UNO::LOAD::LoadGenerator(config).run([](const UNO::LOAD::LoadReport &progress) {
+            std::cerr << progress.toJson() << std::endl;
+        });
+        std::cout << report.toJson() << std::endl;
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
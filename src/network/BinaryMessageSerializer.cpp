@@ -0,0 +1,337 @@
+/**
+ * @file BinaryMessageSerializer.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.13
+ */
+#include "BinaryMessageSerializer.h"
+
+#include <ranges>
+#include <stdexcept>
+
+namespace UNO::NETWORK {
+    void BinaryMessageSerializer::serializeCard(COMMON::BinaryWriter &writer, const GAME::Card &card)
+    {
+        writer.writeByte(static_cast<uint8_t>(static_cast<uint8_t>(card.getColor()) << 4 | static_cast<uint8_t>(card.getType())));
+    }
+
+    template<typename Iterator>
+    void BinaryMessageSerializer::serializeCards(COMMON::BinaryWriter &writer, size_t count, Iterator begin, Iterator end)
+    {
+        writer.writeVarint(count);
+        for (auto it = begin; it != end; ++it) {
+            serializeCard(writer, *it);
+        }
+    }
+
+    void BinaryMessageSerializer::serializeClientPlayerState(COMMON::BinaryWriter &writer, const GAME::ClientPlayerState &state)
+    {
+        writer.writeString(state.getName());
+        writer.writeVarint(state.getRemainingCardCount());
+        writer.writeByte(state.getIsUno() ? 1 : 0);
+    }
+
+    void BinaryMessageSerializer::serializeDiscardSummary(COMMON::BinaryWriter &writer, const GAME::DiscardSummary &summary)
+    {
+        // 牌数为 0 时没有最上方的牌
+        writer.writeVarint(summary.size);
+        if (summary.top.has_value()) {
+            serializeCard(writer, *summary.top);
+        }
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const std::monostate &payload) {}
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const JoinGamePayload &payload)
+    {
+        writer.writeString(payload.playerName);
+        // 恢复令牌与序号只在重连时追加在名字之后
+        if (payload.resumeToken.empty() == false) {
+            writer.writeString(payload.resumeToken);
+            writer.writeVarint(payload.lastSequence);
+        }
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const StartGamePayload &payload) {}
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const DrawCardPayload &payload)
+    {
+        writer.writeVarint(payload.drawCount);
+        serializeCards(writer, payload.cards.size(), payload.cards.begin(), payload.cards.end());
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const PlayCardPayload &payload)
+    {
+        serializeCard(writer, payload.card);
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const InitGamePayload &payload)
+    {
+        writer.writeVarint(payload.playerId);
+        writer.writeVarint(payload.players.size());
+        for (const auto &player : payload.players) {
+            serializeClientPlayerState(writer, player);
+        }
+        serializeDiscardSummary(writer, payload.discardSummary);
+        serializeCards(writer, payload.handCard.size(), payload.handCard.begin(), payload.handCard.end());
+        writer.writeVarint(payload.currentPlayerIndex);
+
+        // 可选的完整弃牌堆：标记字节之后是牌的列表
+        writer.writeByte(payload.discardPile.has_value() ? 1 : 0);
+        if (payload.discardPile.has_value()) {
+            const auto &discardPile = payload.discardPile->getCards();
+            serializeCards(writer, discardPile.size(), discardPile.begin(), discardPile.end());
+        }
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const EndGamePayload &payload) {}
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const AckPayload &payload)
+    {
+        writer.writeVarint(payload.sequence);
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const SyncRequestPayload &payload)
+    {
+        writer.writeVarint(payload.fromSequence);
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const SessionPayload &payload)
+    {
+        writer.writeString(payload.resumeToken);
+    }
+
+    void BinaryMessageSerializer::serializePayload(COMMON::BinaryWriter &writer, const SyncPayload &payload)
+    {
+        writer.writeVarint(payload.playerId);
+        writer.writeVarint(payload.players.size());
+        for (const auto &player : payload.players) {
+            serializeClientPlayerState(writer, player);
+        }
+        serializeDiscardSummary(writer, payload.discardSummary);
+        serializeCards(writer, payload.handCard.size(), payload.handCard.begin(), payload.handCard.end());
+        writer.writeVarint(payload.currentPlayerIndex);
+        writer.writeByte(payload.isReversed ? 1 : 0);
+        writer.writeVarint(payload.drawCount);
+    }
+
+    std::string BinaryMessageSerializer::serialize(const Message &message)
+    {
+        COMMON::BinaryWriter writer;
+        if (message.getSequence() == NoSequence) {
+            writer.writeByte(FrameTag);
+        }
+        else {
+            writer.writeByte(SequencedFrameTag);
+            writer.writeVarint(message.getSequence());
+        }
+        writer.writeByte(static_cast<uint8_t>(message.getMessageStatus()));
+        writer.writeByte(static_cast<uint8_t>(message.getMessagePayloadType()));
+        std::visit([&writer](auto &&value) { serializePayload(writer, value); }, message.getMessagePayload());
+        return writer.release();
+    }
+
+    GAME::Card BinaryMessageSerializer::deserializeCard(COMMON::BinaryReader &reader)
+    {
+        uint8_t card  = reader.readByte();
+        uint8_t color = card >> 4;
+        uint8_t type  = card & 0x0F;
+        if (color >= GAME::AllColors.size()) {
+            throw std::invalid_argument("Invalid card color in binary message: " + std::to_string(color));
+        }
+        if (type >= GAME::AllTypes.size()) {
+            throw std::invalid_argument("Invalid card type in binary message: " + std::to_string(type));
+        }
+        return {GAME::AllColors[color], GAME::AllTypes[type]};
+    }
+
+    std::vector<GAME::Card> BinaryMessageSerializer::deserializeCards(COMMON::BinaryReader &reader)
+    {
+        uint64_t count = reader.readVarint();
+        // 每张牌占一个字节，先检查长度再分配，避免恶意的数量导致巨大的分配
+        if (count > reader.remaining()) {
+            throw std::invalid_argument("Invalid card count in binary message: exceeds remaining data");
+        }
+
+        std::vector<GAME::Card> cards;
+        cards.reserve(count);
+        for (uint64_t i = 0; i < count; i++) {
+            cards.push_back(deserializeCard(reader));
+        }
+        return cards;
+    }
+
+    GAME::ClientPlayerState BinaryMessageSerializer::deserializeClientPlayerState(COMMON::BinaryReader &reader)
+    {
+        auto name           = reader.readString();
+        auto remainingCards = reader.readVarint();
+        auto isUno          = reader.readByte();
+        if (isUno > 1) {
+            throw std::invalid_argument("Invalid 'is_uno' field in binary player state: expected 0 or 1");
+        }
+        return {name, remainingCards, isUno == 1};
+    }
+
+    JoinGamePayload BinaryMessageSerializer::deserializeJoinGamePayload(COMMON::BinaryReader &reader)
+    {
+        auto playerName = reader.readString();
+        if (reader.isEnd()) {
+            return {std::move(playerName), "", NoSequence};
+        }
+
+        auto resumeToken = reader.readString();
+        if (resumeToken.empty()) {
+            throw std::invalid_argument("Invalid binary JOIN_GAME payload: empty resume token");
+        }
+        auto lastSequence = reader.readVarint();
+        return {std::move(playerName), std::move(resumeToken), lastSequence};
+    }
+
+    DrawCardPayload BinaryMessageSerializer::deserializeDrawCardPayload(COMMON::BinaryReader &reader)
+    {
+        auto drawCount = reader.readVarint();
+        return {drawCount, deserializeCards(reader)};
+    }
+
+    PlayCardPayload BinaryMessageSerializer::deserializePlayCardPayload(COMMON::BinaryReader &reader)
+    {
+        return {deserializeCard(reader)};
+    }
+
+    InitGamePayload BinaryMessageSerializer::deserializeInitGamePayload(COMMON::BinaryReader &reader)
+    {
+        auto playerId       = reader.readVarint();
+        auto players        = deserializeClientPlayerStates(reader);
+        auto discardSummary = deserializeDiscardSummary(reader);
+
+        auto handCards = deserializeCards(reader);
+        std::multiset<GAME::Card> handCard(handCards.begin(), handCards.end());
+
+        auto currentPlayer = reader.readVarint();
+
+        std::optional<GAME::DiscardPile> discardPile;
+        auto hasDiscardPile = reader.readByte();
+        if (hasDiscardPile > 1) {
+            throw std::invalid_argument("Invalid discard pile flag in binary INIT_GAME payload: expected 0 or 1");
+        }
+        if (hasDiscardPile == 1) {
+            discardPile.emplace();
+            for (const auto &card : std::views::reverse(deserializeCards(reader))) {
+                discardPile->add(card);
+            }
+        }
+        return {playerId, std::move(players), discardSummary, std::move(handCard), currentPlayer, std::move(discardPile)};
+    }
+
+    GAME::DiscardSummary BinaryMessageSerializer::deserializeDiscardSummary(COMMON::BinaryReader &reader)
+    {
+        auto size = reader.readVarint();
+        if (size == 0) {
+            return {std::nullopt, 0};
+        }
+        return {deserializeCard(reader), size};
+    }
+
+    std::vector<GAME::ClientPlayerState> BinaryMessageSerializer::deserializeClientPlayerStates(COMMON::BinaryReader &reader)
+    {
+        auto playerCount = reader.readVarint();
+        // 每个玩家至少占三个字节
+        if (playerCount > reader.remaining() / 3) {
+            throw std::invalid_argument("Invalid player count in binary message: exceeds remaining data");
+        }
+
+        std::vector<GAME::ClientPlayerState> players;
+        players.reserve(playerCount);
+        for (uint64_t i = 0; i < playerCount; i++) {
+            players.push_back(deserializeClientPlayerState(reader));
+        }
+        return players;
+    }
+
+    SyncPayload BinaryMessageSerializer::deserializeSyncPayload(COMMON::BinaryReader &reader)
+    {
+        auto playerId       = reader.readVarint();
+        auto players        = deserializeClientPlayerStates(reader);
+        auto discardSummary = deserializeDiscardSummary(reader);
+
+        auto handCards = deserializeCards(reader);
+        std::multiset<GAME::Card> handCard(handCards.begin(), handCards.end());
+
+        auto currentPlayer = reader.readVarint();
+        auto isReversed    = reader.readByte();
+        if (isReversed > 1) {
+            throw std::invalid_argument("Invalid 'is_reversed' field in binary SYNC payload: expected 0 or 1");
+        }
+        auto drawCount = reader.readVarint();
+        return {playerId, std::move(players), discardSummary, std::move(handCard), currentPlayer, isReversed == 1, drawCount};
+    }
+
+    MessagePayloadType BinaryMessageSerializer::deserializeMessagePayloadType(uint8_t messagePayloadType)
+    {
+        if (messagePayloadType > static_cast<uint8_t>(MessagePayloadType::SESSION)) {
+            throw std::invalid_argument("Invalid message payload type in binary message: " + std::to_string(messagePayloadType));
+        }
+        return static_cast<MessagePayloadType>(messagePayloadType);
+    }
+
+    MessageStatus BinaryMessageSerializer::deserializeMessageStatus(uint8_t messageStatus)
+    {
+        if (messageStatus > static_cast<uint8_t>(MessageStatus::INVALID)) {
+            throw std::invalid_argument("Invalid message status in binary message: " + std::to_string(messageStatus));
+        }
+        return static_cast<MessageStatus>(messageStatus);
+    }
+
+    MessageHeader BinaryMessageSerializer::deserializeHeader(std::string_view data)
+    {
+        COMMON::BinaryReader reader(data);
+        auto tag = reader.readByte();
+        if (tag != FrameTag && tag != SequencedFrameTag) {
+            throw std::invalid_argument("Invalid binary message: missing frame tag");
+        }
+
+        uint64_t sequence = NoSequence;
+        if (tag == SequencedFrameTag) {
+            sequence = reader.readVarint();
+            if (sequence == NoSequence) {
+                throw std::invalid_argument("Invalid binary message: sequenced frame without sequence number");
+            }
+        }
+
+        auto status      = deserializeMessageStatus(reader.readByte());
+        auto payloadType = deserializeMessagePayloadType(reader.readByte());
+        return {status, payloadType, sequence, data.substr(data.size() - reader.remaining())};
+    }
+
+    MessagePayload BinaryMessageSerializer::deserializePayload(MessagePayloadType payloadType, std::string_view payload)
+    {
+        COMMON::BinaryReader reader(payload);
+
+        MessagePayload result;
+        switch (payloadType) {
+            case MessagePayloadType::EMPTY: result = std::monostate{}; break;
+            case MessagePayloadType::JOIN_GAME: result = deserializeJoinGamePayload(reader); break;
+            case MessagePayloadType::START_GAME: result = StartGamePayload{}; break;
+            case MessagePayloadType::DRAW_CARD: result = deserializeDrawCardPayload(reader); break;
+            case MessagePayloadType::PLAY_CARD: result = deserializePlayCardPayload(reader); break;
+            case MessagePayloadType::INIT_GAME: result = deserializeInitGamePayload(reader); break;
+            case MessagePayloadType::END_GAME: result = EndGamePayload{}; break;
+            case MessagePayloadType::ACK: result = AckPayload{reader.readVarint()}; break;
+            case MessagePayloadType::SYNC_REQUEST: result = SyncRequestPayload{reader.readVarint()}; break;
+            case MessagePayloadType::SYNC: result = deserializeSyncPayload(reader); break;
+            case MessagePayloadType::SESSION: result = SessionPayload{reader.readString()}; break;
+        }
+
+        if (reader.isEnd() == false) {
+            throw std::invalid_argument("Invalid binary message: trailing bytes after payload");
+        }
+        return result;
+    }
+
+    Message BinaryMessageSerializer::deserialize(const std::string &data)
+    {
+        auto header = deserializeHeader(data);
+        return {header.status, header.payloadType, deserializePayload(header.payloadType, header.payload), header.sequence};
+    }
+
+}   // namespace UNO::NETWORK
@@ -0,0 +1,92 @@
+/**
+ * @file BinaryMessageSerializer.h
+ *
+ * 消息的紧凑二进制编码
+ *
+ * 帧格式：标记字节、状态、负载类型各占一个字节，随后是负载；属于状态流的消息使用 SequencedFrameTag，
+ * 并在标记字节之后写入变长整数形式的序列号；
+ * 每张牌占一个字节（高 4 位颜色、低 4 位类型），数量使用 LEB128 变长整数，字符串带长度前缀
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.13
+ */
+#pragma once
+#include "../common/BinaryCodec.h"
+#include "Message.h"
+
+#include <cstdint>
+#include <string>
+
+namespace UNO::NETWORK {
+
+    class BinaryMessageSerializer {
+    public:
+        /**
+         * 二进制帧的第一个字节；JSON 文本不可能以它开头，据此区分两种编码
+         */
+        static constexpr uint8_t FrameTag = 0x01;
+
+        /**
+         * 带序列号的二进制帧的第一个字节
+         */
+        static constexpr uint8_t SequencedFrameTag = 0x02;
+
+        static std::string serialize(const Message &message);
+        static Message deserialize(const std::string &data);
+
+        /**
+         * 只解码帧头
+         * @param data 完整的二进制帧
+         * @return 消息头，负载指向 data 内部
+         */
+        static MessageHeader deserializeHeader(std::string_view data);
+
+        /**
+         * 解码负载
+         * @param payloadType 负载类型
+         * @param payload 负载的原始数据
+         * @return 负载
+         */
+        static MessagePayload deserializePayload(MessagePayloadType payloadType, std::string_view payload);
+
+        /**
+         * 一张牌编码为一个字节：高 4 位为颜色，低 4 位为类型
+         */
+        static void serializeCard(COMMON::BinaryWriter &writer, const GAME::Card &card);
+        static GAME::Card deserializeCard(COMMON::BinaryReader &reader);
+
+    private:
+        template<typename Iterator>
+        static void serializeCards(COMMON::BinaryWriter &writer, size_t count, Iterator begin, Iterator end);
+
+        static void serializeClientPlayerState(COMMON::BinaryWriter &writer, const GAME::ClientPlayerState &state);
+        static void serializeDiscardSummary(COMMON::BinaryWriter &writer, const GAME::DiscardSummary &summary);
+
+        static void serializePayload(COMMON::BinaryWriter &writer, const std::monostate &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const JoinGamePayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const StartGamePayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const DrawCardPayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const PlayCardPayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const InitGamePayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const EndGamePayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const AckPayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const SyncRequestPayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const SyncPayload &payload);
+        static void serializePayload(COMMON::BinaryWriter &writer, const SessionPayload &payload);
+
+        static std::vector<GAME::Card> deserializeCards(COMMON::BinaryReader &reader);
+        static GAME::ClientPlayerState deserializeClientPlayerState(COMMON::BinaryReader &reader);
+
+        static JoinGamePayload deserializeJoinGamePayload(COMMON::BinaryReader &reader);
+        static DrawCardPayload deserializeDrawCardPayload(COMMON::BinaryReader &reader);
+        static PlayCardPayload deserializePlayCardPayload(COMMON::BinaryReader &reader);
+        static InitGamePayload deserializeInitGamePayload(COMMON::BinaryReader &reader);
+        static std::vector<GAME::ClientPlayerState> deserializeClientPlayerStates(COMMON::BinaryReader &reader);
+        static GAME::DiscardSummary deserializeDiscardSummary(COMMON::BinaryReader &reader);
+        static SyncPayload deserializeSyncPayload(COMMON::BinaryReader &reader);
+
+        static MessagePayloadType deserializeMessagePayloadType(uint8_t messagePayloadType);
+        static MessageStatus deserializeMessageStatus(uint8_t messageStatus);
+    };
+
+}   // namespace UNO::NETWORK
@@ -0,0 +1,31 @@
+/**
+ * @file HandlerAllocator.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.11
+ */
+#include "HandlerAllocator.h"
+
+#include <new>
+
+namespace UNO::NETWORK {
+    HandlerMemory::HandlerMemory() : storage_(), isInUse_(false) {}
+
+    void *HandlerMemory::allocate(size_t size)
+    {
+        if (this->isInUse_ == false && size <= this->storage_.size()) {
+            this->isInUse_ = true;
+            return this->storage_.data();
+        }
+        return ::operator new(size);
+    }
+
+    void HandlerMemory::deallocate(void *pointer)
+    {
+        if (pointer == this->storage_.data()) {
+            this->isInUse_ = false;
+            return;
+        }
+        ::operator delete(pointer);
+    }
+}   // namespace UNO::NETWORK
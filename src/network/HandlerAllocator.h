@@ -0,0 +1,85 @@
+/**
+ * @file HandlerAllocator.h
+ *
+ * 会话私有的异步完成处理器内存
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.11
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace UNO::NETWORK {
+
+    /**
+     * 可复用的处理器内存块
+     *
+     * 一条读（写）链同一时刻只有一个未完成的异步操作，操作完成时 asio 会先释放它的内存再分发处理器，
+     * 所以一块固定大小的内存就能被反复使用；放不下或正被占用时退回到堆分配
+     */
+    class HandlerMemory {
+    private:
+        alignas(std::max_align_t) std::array<std::byte, 1024> storage_;
+        bool isInUse_;
+
+    public:
+        HandlerMemory();
+
+        HandlerMemory(const HandlerMemory &)            = delete;
+        HandlerMemory &operator=(const HandlerMemory &) = delete;
+
+        /**
+         * 分配处理器内存
+         * @param size 需要的字节数
+         * @return 分配到的内存
+         */
+        void *allocate(size_t size);
+
+        /**
+         * 释放处理器内存
+         * @param pointer 要释放的内存
+         */
+        void deallocate(void *pointer);
+    };
+
+    /**
+     * 作为 asio 关联分配器使用的 HandlerMemory 适配器
+     * @tparam T 分配的元素类型
+     */
+    template<typename T>
+    class HandlerAllocator {
+    private:
+        template<typename>
+        friend class HandlerAllocator;
+
+        HandlerMemory &memory_;
+
+    public:
+        using value_type = T;
+
+        explicit HandlerAllocator(HandlerMemory &memory) : memory_(memory) {}
+
+        template<typename U>
+        HandlerAllocator(const HandlerAllocator<U> &other) noexcept : memory_(other.memory_)
+        {
+        }
+
+        bool operator==(const HandlerAllocator &other) const noexcept
+        {
+            return &memory_ == &other.memory_;
+        }
+
+        T *allocate(size_t n) const
+        {
+            return static_cast<T *>(memory_.allocate(sizeof(T) * n));
+        }
+
+        void deallocate(T *pointer, size_t) const
+        {
+            memory_.deallocate(pointer);
+        }
+    };
+
+}   // namespace UNO::NETWORK
@@ -10,8 +10,8 @@
 #include <utility>
 
 namespace UNO::NETWORK {
-    Message::Message(MessageStatus messageStatus, MessagePayloadType messagePayloadType, MessagePayload messagePayload) :
-        status_(messageStatus), messagePayloadType_(messagePayloadType), messagePayload_(std::move(messagePayload))
+    Message::Message(MessageStatus messageStatus, MessagePayloadType messagePayloadType, MessagePayload messagePayload, uint64_t sequence) :
+        status_(messageStatus), messagePayloadType_(messagePayloadType), messagePayload_(std::move(messagePayload)), sequence_(sequence)
     {
         if (this->getMessageStatus() == MessageStatus::INVALID) {
             if (this->getMessagePayloadType() != MessagePayloadType::EMPTY) {
@@ -33,7 +33,15 @@ namespace UNO::NETWORK {
                 || (this->getMessagePayloadType() == MessagePayloadType::INIT_GAME
                     && std::holds_alternative<InitGamePayload>(this->getMessagePayload()) == false)
                 || (this->getMessagePayloadType() == MessagePayloadType::END_GAME
-                    && std::holds_alternative<EndGamePayload>(this->getMessagePayload()) == false)) {
+                    && std::holds_alternative<EndGamePayload>(this->getMessagePayload()) == false)
+                || (this->getMessagePayloadType() == MessagePayloadType::ACK
+                    && std::holds_alternative<AckPayload>(this->getMessagePayload()) == false)
+                || (this->getMessagePayloadType() == MessagePayloadType::SYNC_REQUEST
+                    && std::holds_alternative<SyncRequestPayload>(this->getMessagePayload()) == false)
+                || (this->getMessagePayloadType() == MessagePayloadType::SYNC
+                    && std::holds_alternative<SyncPayload>(this->getMessagePayload()) == false)
+                || (this->getMessagePayloadType() == MessagePayloadType::SESSION
+                    && std::holds_alternative<SessionPayload>(this->getMessagePayload()) == false)) {
                 throw std::invalid_argument("Invalid message: MessagePayloadType and MessagePayload do not match");
             }
         }
@@ -49,10 +57,20 @@ namespace UNO::NETWORK {
         return this->messagePayloadType_;
     }
 
-    MessagePayload Message::getMessagePayload() const
+    uint64_t Message::getSequence() const
+    {
+        return this->sequence_;
+    }
+
+    const MessagePayload &Message::getMessagePayload() const &
     {
         return this->messagePayload_;
     }
 
+    MessagePayload Message::getMessagePayload() &&
+    {
+        return std::move(this->messagePayload_);
+    }
+
 
 }   // namespace UNO::NETWORK
\ No newline at end of file
@@ -12,16 +12,44 @@
 #include "../game/Player.h"
 
 
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
 
 namespace UNO::NETWORK {
-    enum class MessagePayloadType { EMPTY, JOIN_GAME, START_GAME, DRAW_CARD, PLAY_CARD, INIT_GAME, END_GAME };
+    enum class MessagePayloadType {
+        EMPTY,
+        JOIN_GAME,
+        START_GAME,
+        DRAW_CARD,
+        PLAY_CARD,
+        INIT_GAME,
+        END_GAME,
+        ACK,
+        SYNC_REQUEST,
+        SYNC,
+        SESSION
+    };
 
+    /**
+     * 加入对局；断线重连时带上服务端发放的恢复令牌，重新绑定原来的座位
+     */
     struct JoinGamePayload {
         std::string playerName;
+
+        /**
+         * 恢复令牌，为空表示新加入的玩家
+         */
+        std::string resumeToken;
+
+        /**
+         * 重连前已经应用的最后一个状态事件的序号，服务端只补发之后的事件
+         */
+        uint64_t lastSequence;
     };
 
     struct StartGamePayload {};
@@ -38,18 +66,85 @@ namespace UNO::NETWORK {
     struct InitGamePayload {
         size_t playerId;
         std::vector<GAME::ClientPlayerState> players;
-        GAME::DiscardPile discardPile;
+        GAME::DiscardSummary discardSummary;
         std::multiset<GAME::Card> handCard;
         size_t currentPlayerIndex;
+
+        /**
+         * 完整的弃牌堆，只在服务端开启调试选项时发送
+         */
+        std::optional<GAME::DiscardPile> discardPile;
     };
 
     struct EndGamePayload {};
 
-    using MessagePayload =
-        std::variant<std::monostate, JoinGamePayload, StartGamePayload, DrawCardPayload, PlayCardPayload, InitGamePayload, EndGamePayload>;
+    /**
+     * 客户端确认已经应用了序号不超过 sequence 的所有状态事件
+     */
+    struct AckPayload {
+        uint64_t sequence;
+    };
+
+    /**
+     * 客户端请求序号大于 fromSequence 的所有状态事件
+     */
+    struct SyncRequestPayload {
+        uint64_t fromSequence;
+    };
+
+    /**
+     * 对局的最小快照：只包含弃牌堆顶和各玩家的牌数，不包含历史
+     */
+    struct SyncPayload {
+        size_t playerId;
+        std::vector<GAME::ClientPlayerState> players;
+        GAME::DiscardSummary discardSummary;
+        std::multiset<GAME::Card> handCard;
+        size_t currentPlayerIndex;
+        bool isReversed;
+        size_t drawCount;
+    };
+
+    /**
+     * 服务端在玩家加入后发放的恢复令牌
+     */
+    struct SessionPayload {
+        std::string resumeToken;
+    };
+
+    using MessagePayload = std::variant<std::monostate,
+                                        JoinGamePayload,
+                                        StartGamePayload,
+                                        DrawCardPayload,
+                                        PlayCardPayload,
+                                        InitGamePayload,
+                                        EndGamePayload,
+                                        AckPayload,
+                                        SyncRequestPayload,
+                                        SyncPayload,
+                                        SessionPayload>;
 
     enum class MessageStatus { OK, INVALID };
 
+    /**
+     * 已解码的消息头与尚未解码的负载
+     */
+    struct MessageHeader {
+        MessageStatus status;
+        MessagePayloadType payloadType;
+        uint64_t sequence;
+
+        /**
+         * 负载的原始数据，指向接收缓冲区
+         */
+        std::string_view payload;
+    };
+
+    /**
+     * 不属于状态流的消息的序号
+     */
+    constexpr uint64_t NoSequence = 0;
+
     class Message {
     private:
         MessageStatus status_;
@@ -57,12 +152,30 @@ namespace UNO::NETWORK {
         MessagePayloadType messagePayloadType_;
         MessagePayload messagePayload_;
 
+        /**
+         * 状态流中的序号，从 1 开始单调递增；NoSequence 表示消息不属于状态流
+         */
+        uint64_t sequence_;
+
     public:
-        Message(MessageStatus messageStatus, MessagePayloadType messagePayloadType, MessagePayload messagePayload);
+        Message(MessageStatus messageStatus,
+                MessagePayloadType messagePayloadType,
+                MessagePayload messagePayload,
+                uint64_t sequence = NoSequence);
 
         [[nodiscard]] MessageStatus getMessageStatus() const;
         [[nodiscard]] MessagePayloadType getMessagePayloadType() const;
-        [[nodiscard]] MessagePayload getMessagePayload() const;
+        [[nodiscard]] uint64_t getSequence() const;
+        /**
+         * @return 负载的引用，不复制负载
+         */
+        [[nodiscard]] const MessagePayload &getMessagePayload() const &;
+
+        /**
+         * 从即将销毁的消息中移出负载
+         * @return 负载
+         */
+        [[nodiscard]] MessagePayload getMessagePayload() &&;
     };
 
 }   // namespace UNO::NETWORK
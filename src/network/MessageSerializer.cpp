@@ -6,82 +6,189 @@
  */
 #include "MessageSerializer.h"
 
+#include "../common/PerfectHash.h"
+#include "BinaryMessageSerializer.h"
+#include "MessageView.h"
+
+#include <array>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
 namespace UNO::NETWORK {
-    nlohmann::json MessageSerializer::serializeCard(const GAME::Card &card)
+    // 对象的键按字典序写入，与 nlohmann::json 的 std::map 存储顺序一致，输出与原先的 dump() 逐字节相同
+
+    void MessageSerializer::serializeCard(COMMON::JsonWriter &writer, const GAME::Card &card)
     {
-        return {{"card_color", card.colorToString()}, {"card_type", card.typeToString()}};
+        writer.beginObject();
+        writer.key("card_color");
+        writer.stringValue(card.colorToString());
+        writer.key("card_type");
+        writer.stringValue(card.typeToString());
+        writer.endObject();
     }
 
     template<typename Iterator>
-    nlohmann::json MessageSerializer::serializeCards(Iterator begin, Iterator end)
+    void MessageSerializer::serializeCards(COMMON::JsonWriter &writer, Iterator begin, Iterator end)
     {
-        nlohmann::json res = nlohmann::json::array();
+        writer.beginArray();
         for (auto it = begin; it != end; ++it) {
-            res.push_back(serializeCard(*it));
+            serializeCard(writer, *it);
         }
-        return res;
+        writer.endArray();
     }
 
-    nlohmann::json MessageSerializer::serializeDiscardPile(const GAME::DiscardPile &discardPile)
+    void MessageSerializer::serializeClientPlayerState(COMMON::JsonWriter &writer, const GAME::ClientPlayerState &state)
     {
-        const auto &cards = discardPile.getCards();
-        return serializeCards(cards.begin(), cards.end());
+        writer.beginObject();
+        writer.key("is_uno");
+        writer.boolValue(state.getIsUno());
+        writer.key("name");
+        writer.stringValue(state.getName());
+        writer.key("remaining_cards");
+        writer.numberValue(state.getRemainingCardCount());
+        writer.endObject();
     }
 
-    nlohmann::json MessageSerializer::serializeClientPlayerState(const GAME::ClientPlayerState &state)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const std::monostate &payload)
     {
-        return {{"name", state.getName()}, {"remaining_cards", state.getRemainingCardCount()}, {"is_uno", state.getIsUno()}};
+        writer.nullValue();
     }
 
-    nlohmann::json MessageSerializer::serializeClientPlayerStates(const std::vector<GAME::ClientPlayerState> &states)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const JoinGamePayload &payload)
     {
-        nlohmann::json result = nlohmann::json::array();
-        for (const auto &state : states) {
-            result.push_back(serializeClientPlayerState(state));
+        // 只有重连时才写出恢复令牌，新加入的消息与之前的格式相同
+        writer.beginObject();
+        if (payload.resumeToken.empty() == false) {
+            writer.key("last_sequence");
+            writer.numberValue(payload.lastSequence);
         }
-        return result;
+        writer.key("name");
+        writer.stringValue(payload.playerName);
+        if (payload.resumeToken.empty() == false) {
+            writer.key("resume_token");
+            writer.stringValue(payload.resumeToken);
+        }
+        writer.endObject();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const std::monostate &payload)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const StartGamePayload &payload)
     {
-        return nullptr;
+        writer.nullValue();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const JoinGamePayload &payload)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const DrawCardPayload &payload)
     {
-        return {{"name", payload.playerName}};
+        writer.beginObject();
+        writer.key("cards");
+        serializeCards(writer, payload.cards.begin(), payload.cards.end());
+        writer.key("draw_count");
+        writer.numberValue(payload.drawCount);
+        writer.endObject();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const StartGamePayload &payload)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const PlayCardPayload &payload)
     {
-        return nullptr;
+        writer.beginObject();
+        writer.key("card");
+        serializeCard(writer, payload.card);
+        writer.endObject();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const DrawCardPayload &payload)
+    void MessageSerializer::serializeDiscardSummary(COMMON::JsonWriter &writer, const GAME::DiscardSummary &summary)
     {
-        return {{"draw_count", payload.drawCount}, {"cards", serializeCards(payload.cards.begin(), payload.cards.end())}};
+        writer.beginObject();
+        writer.key("size");
+        writer.numberValue(summary.size);
+        writer.key("top");
+        if (summary.top.has_value()) {
+            serializeCard(writer, *summary.top);
+        }
+        else {
+            writer.nullValue();
+        }
+        writer.endObject();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const PlayCardPayload &payload)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const InitGamePayload &payload)
     {
-        return {{"card", serializeCard(payload.card)}};
+        writer.beginObject();
+        writer.key("current_player");
+        writer.numberValue(payload.currentPlayerIndex);
+        writer.key("discard");
+        serializeDiscardSummary(writer, payload.discardSummary);
+        if (payload.discardPile.has_value()) {
+            const auto &discardPile = payload.discardPile->getCards();
+            writer.key("discard_pile");
+            serializeCards(writer, discardPile.begin(), discardPile.end());
+        }
+        writer.key("hand_card");
+        serializeCards(writer, payload.handCard.begin(), payload.handCard.end());
+        writer.key("player_id");
+        writer.numberValue(payload.playerId);
+        writer.key("players");
+        writer.beginArray();
+        for (const auto &player : payload.players) {
+            serializeClientPlayerState(writer, player);
+        }
+        writer.endArray();
+        writer.endObject();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const InitGamePayload &payload)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const EndGamePayload &payload)
     {
-        return {{"player_id", payload.playerId},
-                {"players", serializeClientPlayerStates(payload.players)},
-                {"discard_pile", serializeDiscardPile(payload.discardPile)},
-                {"hand_card", serializeCards(payload.handCard.begin(), payload.handCard.end())},
-                {"current_player", payload.currentPlayerIndex}};
+        writer.nullValue();
     }
 
-    nlohmann::json MessageSerializer::serializePayload(const EndGamePayload &payload)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const AckPayload &payload)
     {
-        return nullptr;
+        writer.beginObject();
+        writer.key("sequence");
+        writer.numberValue(payload.sequence);
+        writer.endObject();
     }
 
-    std::string MessageSerializer::serializeMessagePayloadType(const MessagePayloadType &messagePayloadType)
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const SyncRequestPayload &payload)
+    {
+        writer.beginObject();
+        writer.key("from_sequence");
+        writer.numberValue(payload.fromSequence);
+        writer.endObject();
+    }
+
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const SessionPayload &payload)
+    {
+        writer.beginObject();
+        writer.key("resume_token");
+        writer.stringValue(payload.resumeToken);
+        writer.endObject();
+    }
+
+    void MessageSerializer::serializePayload(COMMON::JsonWriter &writer, const SyncPayload &payload)
+    {
+        writer.beginObject();
+        writer.key("current_player");
+        writer.numberValue(payload.currentPlayerIndex);
+        writer.key("discard");
+        serializeDiscardSummary(writer, payload.discardSummary);
+        writer.key("draw_count");
+        writer.numberValue(payload.drawCount);
+        writer.key("hand_card");
+        serializeCards(writer, payload.handCard.begin(), payload.handCard.end());
+        writer.key("is_reversed");
+        writer.boolValue(payload.isReversed);
+        writer.key("player_id");
+        writer.numberValue(payload.playerId);
+        writer.key("players");
+        writer.beginArray();
+        for (const auto &player : payload.players) {
+            serializeClientPlayerState(writer, player);
+        }
+        writer.endArray();
+        writer.endObject();
+    }
+
+    std::string_view MessageSerializer::serializeMessagePayloadType(const MessagePayloadType &messagePayloadType)
     {
         switch (messagePayloadType) {
             case MessagePayloadType::EMPTY: return "EMPTY";
@@ -91,11 +198,15 @@ namespace UNO::NETWORK {
             case MessagePayloadType::PLAY_CARD: return "PLAY_CARD";
             case MessagePayloadType::INIT_GAME: return "INIT_GAME";
             case MessagePayloadType::END_GAME: return "END_GAME";
+            case MessagePayloadType::ACK: return "ACK";
+            case MessagePayloadType::SYNC_REQUEST: return "SYNC_REQUEST";
+            case MessagePayloadType::SYNC: return "SYNC";
+            case MessagePayloadType::SESSION: return "SESSION";
         }
         throw std::invalid_argument("invalid message payload type");
     }
 
-    std::string MessageSerializer::serializeMessageStatus(const MessageStatus &messageStatus)
+    std::string_view MessageSerializer::serializeMessageStatus(const MessageStatus &messageStatus)
     {
         switch (messageStatus) {
             case MessageStatus::OK: return "OK";
@@ -104,298 +215,492 @@ namespace UNO::NETWORK {
         std::unreachable();
     }
 
-    nlohmann::json MessageSerializer::serializeMessage(const Message &message)
-    {
-        return {{"status_code", serializeMessageStatus(message.getMessageStatus())},
-                {"payload_type", serializeMessagePayloadType(message.getMessagePayloadType())},
-                {"payload", std::visit([](auto &&value) { return serializePayload(value); }, message.getMessagePayload())}};
-    }
+    void MessageSerializer::serializeMessage(COMMON::JsonWriter &writer, const Message &message)
+    {
+        writer.beginObject();
+        writer.key("payload");
+        std::visit([&writer](auto &&value) { serializePayload(writer, value); }, message.getMessagePayload());
+        writer.key("payload_type");
+        writer.stringValue(serializeMessagePayloadType(message.getMessagePayloadType()));
+        if (message.getSequence() != NoSequence) {
+            writer.key("sequence");
+            writer.numberValue(message.getSequence());
+        }
+        writer.key("status_code");
+        writer.stringValue(serializeMessageStatus(message.getMessageStatus()));
+        writer.endObject();
+    }
+
+    std::string MessageSerializer::serialize(const Message &message, MessageEncoding encoding)
+    {
+        std::string buffer;
+        serialize(message, buffer, encoding);
+        return buffer;
+    }
+
+    void MessageSerializer::serialize(const Message &message, std::string &buffer, MessageEncoding encoding)
+    {
+        if (encoding == MessageEncoding::BINARY) {
+            buffer = BinaryMessageSerializer::serialize(message);
+            return;
+        }
+        buffer.clear();
+        COMMON::JsonWriter writer(buffer);
+        serializeMessage(writer, message);
+    }
+
+    namespace {
+        using namespace std::string_view_literals;
+
+        constexpr std::array<std::string_view, 4> CardColorNames = {"red"sv, "yellow"sv, "blue"sv, "green"sv};
+        constexpr COMMON::PerfectHash CardColorHash(CardColorNames);
+
+        constexpr std::array<std::string_view, 15> CardTypeNames = {"0"sv,
+                                                                    "1"sv,
+                                                                    "2"sv,
+                                                                    "3"sv,
+                                                                    "4"sv,
+                                                                    "5"sv,
+                                                                    "6"sv,
+                                                                    "7"sv,
+                                                                    "8"sv,
+                                                                    "9"sv,
+                                                                    "skip"sv,
+                                                                    "reverse"sv,
+                                                                    "draw_two"sv,
+                                                                    "wild_wild"sv,
+                                                                    "wild_draw_four"sv};
+        constexpr COMMON::PerfectHash CardTypeHash(CardTypeNames);
+
+        constexpr std::array<std::string_view, 11> PayloadTypeNames = {"EMPTY"sv,
+                                                                       "JOIN_GAME"sv,
+                                                                       "START_GAME"sv,
+                                                                       "DRAW_CARD"sv,
+                                                                       "PLAY_CARD"sv,
+                                                                       "INIT_GAME"sv,
+                                                                       "END_GAME"sv,
+                                                                       "ACK"sv,
+                                                                       "SYNC_REQUEST"sv,
+                                                                       "SYNC"sv,
+                                                                       "SESSION"sv};
+        constexpr COMMON::PerfectHash PayloadTypeHash(PayloadTypeNames);
+
+        static_assert(CardColorNames.size() == GAME::AllColors.size());
+        static_assert(CardTypeNames.size() == GAME::AllTypes.size());
+
+        /**
+         * 对象中关心的字段的原始文本
+         *
+         * 只扫描一遍对象，重复的键以最后一次出现为准，与 nlohmann::json 的行为一致
+         * @tparam N 关心的键的数量
+         */
+        template<size_t N>
+        class ObjectFields {
+        private:
+            std::array<std::string_view, N> values_;
+            std::array<bool, N> isPresent_;
+
+        public:
+            ObjectFields(std::string_view object, const std::array<std::string_view, N> &keys) : values_(), isPresent_()
+            {
+                COMMON::JsonReader reader(object);
+                reader.beginObject();
+                std::string key;
+                while (reader.nextMember(key)) {
+                    auto value = reader.skipValue();
+                    for (size_t i = 0; i < N; i++) {
+                        if (key == keys[i]) {
+                            this->values_[i]    = value;
+                            this->isPresent_[i] = true;
+                        }
+                    }
+                }
+            }
 
-    std::string MessageSerializer::serialize(const Message &message)
-    {
-        return serializeMessage(message).dump();
-    }
+            /**
+             * @return 可选的字段是否存在
+             */
+            [[nodiscard]] bool contains(size_t index) const
+            {
+                return this->isPresent_[index];
+            }
 
-    GAME::CardColor MessageSerializer::deserializeCardColor(const std::string &cardColor)
-    {
-        if (cardColor == "red") {
-            return GAME::CardColor::RED;
+            /**
+             * @return 字段的原始文本，字段不存在时抛出 std::invalid_argument
+             */
+            [[nodiscard]] std::string_view at(size_t index, const char *missingMessage) const
+            {
+                if (this->isPresent_[index] == false) {
+                    throw std::invalid_argument(missingMessage);
+                }
+                return this->values_[index];
+            }
+        };
+
+        COMMON::JsonType typeOf(std::string_view value)
+        {
+            return COMMON::JsonReader(value).peek();
         }
-        if (cardColor == "blue") {
-            return GAME::CardColor::BLUE;
+
+        bool isUnsigned(std::string_view value)
+        {
+            return typeOf(value) == COMMON::JsonType::NUMBER && COMMON::JsonReader(value).readNumber().isUnsigned;
         }
-        if (cardColor == "green") {
-            return GAME::CardColor::GREEN;
+
+        uint64_t toUnsigned(std::string_view value)
+        {
+            return COMMON::JsonReader(value).readNumber().value;
         }
-        if (cardColor == "yellow") {
-            return GAME::CardColor::YELLOW;
+
+        std::string toString(std::string_view value)
+        {
+            return COMMON::JsonReader(value).readString();
         }
-        throw std::invalid_argument("Invalid card color: '" + cardColor + "'. Expected: Red, Blue, Green, or Yellow");
-    }
+    }   // namespace
 
-    GAME::CardType MessageSerializer::deserializeCardType(const std::string &cardType)
+    GAME::CardColor MessageSerializer::deserializeCardColor(std::string_view cardColor)
     {
-        if (cardType == "0") {
-            return GAME::CardType::NUM0;
-        }
-        if (cardType == "1") {
-            return GAME::CardType::NUM1;
-        }
-        if (cardType == "2") {
-            return GAME::CardType::NUM2;
-        }
-        if (cardType == "3") {
-            return GAME::CardType::NUM3;
-        }
-        if (cardType == "4") {
-            return GAME::CardType::NUM4;
-        }
-        if (cardType == "5") {
-            return GAME::CardType::NUM5;
-        }
-        if (cardType == "6") {
-            return GAME::CardType::NUM6;
-        }
-        if (cardType == "7") {
-            return GAME::CardType::NUM7;
-        }
-        if (cardType == "8") {
-            return GAME::CardType::NUM8;
-        }
-        if (cardType == "9") {
-            return GAME::CardType::NUM9;
-        }
-        if (cardType == "skip") {
-            return GAME::CardType::SKIP;
-        }
-        if (cardType == "reverse") {
-            return GAME::CardType::REVERSE;
-        }
-        if (cardType == "draw_two") {
-            return GAME::CardType::DRAW2;
+        if (auto index = CardColorHash.find(cardColor)) {
+            return GAME::AllColors[*index];
         }
-        if (cardType == "wild_wild") {
-            return GAME::CardType::WILD;
-        }
-        if (cardType == "wild_draw_four") {
-            return GAME::CardType::WILDDRAWFOUR;
+        throw std::invalid_argument("Invalid card color: '" + std::string(cardColor) + "'. Expected: Red, Blue, Green, or Yellow");
+    }
+
+    GAME::CardType MessageSerializer::deserializeCardType(std::string_view cardType)
+    {
+        if (auto index = CardTypeHash.find(cardType)) {
+            return GAME::AllTypes[*index];
         }
-        throw std::invalid_argument("Invalid card type: '" + cardType + "'. Expected: 0-9, Skip, Reverse, Draw 2, Wild, or Wild Draw 4");
+        throw std::invalid_argument("Invalid card type: '" + std::string(cardType)
+                                    + "'. Expected: 0-9, Skip, Reverse, Draw 2, Wild, or Wild Draw 4");
     }
 
-    GAME::Card MessageSerializer::deserializeCard(const nlohmann::json &card)
+    GAME::Card MessageSerializer::deserializeCard(std::string_view card)
     {
-        if (card.is_object() == false) {
+        if (typeOf(card) != COMMON::JsonType::OBJECT) {
             throw std::invalid_argument("Invalid card format: expected JSON object");
         }
-        try {
-            if (card.at("card_color").is_string() == false) {
-                throw std::invalid_argument("Invalid card_color field: expected string");
-            }
-            if (card.at("card_type").is_string() == false) {
-                throw std::invalid_argument("Invalid card_type field: expected string");
-            }
-            return {deserializeCardColor(card.at("card_color")), deserializeCardType(card.at("card_type"))};
+        constexpr const char *missing = "Missing required field in card: expected 'card_color' and 'card_type'";
+
+        ObjectFields fields(card, std::array{"card_color"sv, "card_type"sv});
+        if (typeOf(fields.at(0, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid card_color field: expected string");
         }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument("Missing required field in card: expected 'card_color' and 'card_type'");
+        if (typeOf(fields.at(1, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid card_type field: expected string");
         }
+        return {deserializeCardColor(toString(fields.at(0, missing))), deserializeCardType(toString(fields.at(1, missing)))};
     }
 
-    GAME::DiscardPile MessageSerializer::deserializeDiscardPile(const nlohmann::json &discardPile)
+    GAME::DiscardPile MessageSerializer::deserializeDiscardPile(std::string_view discardPile)
     {
-        if (discardPile.is_array() == false) {
+        if (typeOf(discardPile) != COMMON::JsonType::ARRAY) {
             throw std::invalid_argument("Invalid discard_pile format: expected JSON array");
         }
 
-        GAME::DiscardPile res;
-        for (const auto &i : std::views::reverse(discardPile)) {
-            res.add(deserializeCard(i));
+        std::vector<GAME::Card> cards;
+        COMMON::JsonReader reader(discardPile);
+        reader.beginArray();
+        while (reader.nextElement()) {
+            cards.push_back(deserializeCard(reader.skipValue()));
         }
 
+        GAME::DiscardPile res;
+        for (const auto &card : std::views::reverse(cards)) {
+            res.add(card);
+        }
         return res;
     }
 
-    std::multiset<GAME::Card> MessageSerializer::deserializeHandCard(const nlohmann::json &handCard)
+    GAME::DiscardSummary MessageSerializer::deserializeDiscardSummary(std::string_view discardSummary)
+    {
+        if (typeOf(discardSummary) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid discard format: expected JSON object");
+        }
+        constexpr const char *missing = "Missing required field in discard: expected 'size' and 'top'";
+
+        ObjectFields fields(discardSummary, std::array{"size"sv, "top"sv});
+        if (isUnsigned(fields.at(0, missing)) == false) {
+            throw std::invalid_argument("Invalid 'size' field in discard: expected unsigned integer");
+        }
+        auto size = toUnsigned(fields.at(0, missing));
+
+        // 只有空的弃牌堆没有最上方的牌
+        bool hasTop = typeOf(fields.at(1, missing)) != COMMON::JsonType::NULL_VALUE;
+        if (hasTop != (size != 0)) {
+            throw std::invalid_argument("Invalid discard: 'top' must be null exactly when 'size' is 0");
+        }
+        if (hasTop == false) {
+            return {std::nullopt, 0};
+        }
+        return {deserializeCard(fields.at(1, missing)), size};
+    }
+
+    std::multiset<GAME::Card> MessageSerializer::deserializeHandCard(std::string_view handCard)
     {
-        if (handCard.is_array() == false) {
+        if (typeOf(handCard) != COMMON::JsonType::ARRAY) {
             throw std::invalid_argument("Invalid hand_card format: expected JSON array");
         }
 
         std::multiset<GAME::Card> res;
-        for (const auto &i : std::views::reverse(handCard)) {
-            res.insert(deserializeCard(i));
+        COMMON::JsonReader reader(handCard);
+        reader.beginArray();
+        while (reader.nextElement()) {
+            res.insert(deserializeCard(reader.skipValue()));
         }
-
         return res;
     }
 
-    GAME::ClientPlayerState MessageSerializer::deserializeClientPlayerState(const nlohmann::json &payload)
+    GAME::ClientPlayerState MessageSerializer::deserializeClientPlayerState(std::string_view payload)
     {
-        try {
-            if (payload.is_object() == false) {
-                throw std::invalid_argument("Invalid player public state: expected JSON object");
-            }
-            if (payload.at("name").is_string() == false) {
-                throw std::invalid_argument("Invalid 'name' field in player public state: expected string");
-            }
-            if (payload.at("remaining_cards").is_number_unsigned() == false) {
-                throw std::invalid_argument("Invalid 'remaining_cards' field in player public state: expected unsigned integer");
-            }
-            if (payload.at("is_uno").is_boolean() == false) {
-                throw std::invalid_argument("Invalid 'is_uno' field in player public state: expected boolean");
-            }
-            return {payload.at("name"), payload.at("remaining_cards"), payload.at("is_uno")};
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid player public state: expected JSON object");
+        }
+        constexpr const char *missing = "Missing required field in player public state: expected 'name', 'remaining_cards', 'is_uno'";
+
+        ObjectFields fields(payload, std::array{"name"sv, "remaining_cards"sv, "is_uno"sv});
+        if (typeOf(fields.at(0, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid 'name' field in player public state: expected string");
+        }
+        if (isUnsigned(fields.at(1, missing)) == false) {
+            throw std::invalid_argument("Invalid 'remaining_cards' field in player public state: expected unsigned integer");
         }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument("Missing required field in player public state: expected 'name', 'remaining_cards', 'is_uno'");
+        if (typeOf(fields.at(2, missing)) != COMMON::JsonType::BOOLEAN) {
+            throw std::invalid_argument("Invalid 'is_uno' field in player public state: expected boolean");
         }
+        return {toString(fields.at(0, missing)), toUnsigned(fields.at(1, missing)), COMMON::JsonReader(fields.at(2, missing)).readBool()};
     }
 
-    std::vector<GAME::ClientPlayerState> MessageSerializer::deserializeClientPlayerStates(const nlohmann::json &payload)
+    std::vector<GAME::ClientPlayerState> MessageSerializer::deserializeClientPlayerStates(std::string_view payload)
     {
-        if (payload.is_array() == false) {
+        if (typeOf(payload) != COMMON::JsonType::ARRAY) {
             throw std::invalid_argument("Invalid players field in INIT_GAME payload: expected JSON array");
         }
 
         std::vector<GAME::ClientPlayerState> players;
-        for (const auto &entry : payload) {
-            players.push_back(deserializeClientPlayerState(entry));
+        COMMON::JsonReader reader(payload);
+        reader.beginArray();
+        while (reader.nextElement()) {
+            players.push_back(deserializeClientPlayerState(reader.skipValue()));
         }
         return players;
     }
 
-    std::monostate MessageSerializer::deserializeEmptyPayload(const nlohmann::json &payload)
+    std::monostate MessageSerializer::deserializeEmptyPayload(std::string_view payload)
     {
-        if (payload.is_null() == false) {
+        if (typeOf(payload) != COMMON::JsonType::NULL_VALUE) {
             throw std::invalid_argument("Invalid payload: expected null for empty payload");
         }
         return {};
     }
 
-
-    JoinGamePayload MessageSerializer::deserializeJoinGamePayload(const nlohmann::json &payload)
+    JoinGamePayload MessageSerializer::deserializeJoinGamePayload(std::string_view payload)
     {
-        try {
-            if (payload.is_object() == false) {
-                throw std::invalid_argument("Invalid JOIN_GAME payload: expected JSON object");
-            }
-            if (payload.at("name").is_string() == false) {
-                throw std::invalid_argument("Invalid 'name' field in JOIN_GAME payload: expected string");
-            }
-            return {payload.at("name")};
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid JOIN_GAME payload: expected JSON object");
+        }
+        constexpr const char *missing = "Missing required field 'name' in JOIN_GAME payload";
+
+        ObjectFields fields(payload, std::array{"name"sv, "resume_token"sv, "last_sequence"sv});
+        if (typeOf(fields.at(0, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid 'name' field in JOIN_GAME payload: expected string");
+        }
+        if (fields.contains(1) == false) {
+            return {toString(fields.at(0, missing)), "", NoSequence};
         }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument("Missing required field 'name' in JOIN_GAME payload");
+
+        // 重连的玩家必须同时给出恢复令牌和已经应用的序号
+        constexpr const char *missingSequence = "Missing required field 'last_sequence' in JOIN_GAME payload with 'resume_token'";
+        if (typeOf(fields.at(1, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid 'resume_token' field in JOIN_GAME payload: expected string");
+        }
+        if (isUnsigned(fields.at(2, missingSequence)) == false) {
+            throw std::invalid_argument("Invalid 'last_sequence' field in JOIN_GAME payload: expected unsigned integer");
         }
+        return {toString(fields.at(0, missing)), toString(fields.at(1, missing)), toUnsigned(fields.at(2, missingSequence))};
     }
 
-    StartGamePayload MessageSerializer::deserializeStartGamePayload(const nlohmann::json &payload)
+    StartGamePayload MessageSerializer::deserializeStartGamePayload(std::string_view payload)
     {
-        if (payload.is_null() == false) {
+        if (typeOf(payload) != COMMON::JsonType::NULL_VALUE) {
             throw std::invalid_argument("Invalid START_GAME payload: expected null");
         }
         return {};
     }
 
-    DrawCardPayload MessageSerializer::deserializeDrawCardPayload(const nlohmann::json &payload)
+    DrawCardPayload MessageSerializer::deserializeDrawCardPayload(std::string_view payload)
     {
-        try {
-            if (payload.is_object() == false) {
-                throw std::invalid_argument("Invalid DRAW_CARD payload: expected JSON object");
-            }
-            if (payload.at("draw_count").is_number_unsigned() == false) {
-                throw std::invalid_argument("Invalid 'draw_count' field in DRAW_CARD payload: expected unsigned integer");
-            }
-            if (payload.at("cards").is_array() == false) {
-                throw std::invalid_argument("Invalid 'cards' field in DRAW_CARD payload: expected JSON array");
-            }
-
-            std::vector<GAME::Card> cards;
-            for (const auto &i : payload.at("cards")) {
-                cards.push_back(deserializeCard(i));
-            }
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid DRAW_CARD payload: expected JSON object");
+        }
+        constexpr const char *missing = "Missing required field 'draw_count' and 'cards' in DRAW_CARD payload";
 
-            return {payload.at("draw_count"), cards};
+        ObjectFields fields(payload, std::array{"draw_count"sv, "cards"sv});
+        if (isUnsigned(fields.at(0, missing)) == false) {
+            throw std::invalid_argument("Invalid 'draw_count' field in DRAW_CARD payload: expected unsigned integer");
         }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument("Missing required field 'draw_count' and 'cards' in DRAW_CARD payload");
+        if (typeOf(fields.at(1, missing)) != COMMON::JsonType::ARRAY) {
+            throw std::invalid_argument("Invalid 'cards' field in DRAW_CARD payload: expected JSON array");
         }
+
+        std::vector<GAME::Card> cards;
+        COMMON::JsonReader reader(fields.at(1, missing));
+        reader.beginArray();
+        while (reader.nextElement()) {
+            cards.push_back(deserializeCard(reader.skipValue()));
+        }
+
+        return {toUnsigned(fields.at(0, missing)), std::move(cards)};
     }
 
-    PlayCardPayload MessageSerializer::deserializePlayCardPayload(const nlohmann::json &payload)
+    PlayCardPayload MessageSerializer::deserializePlayCardPayload(std::string_view payload)
     {
-        try {
-            if (payload.is_object() == false) {
-                throw std::invalid_argument("Invalid PLAY_CARD payload: expected JSON object");
-            }
-            return {deserializeCard(payload.at("card"))};
-        }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument("Missing required field 'card' in PLAY_CARD payload");
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid PLAY_CARD payload: expected JSON object");
         }
+        ObjectFields fields(payload, std::array{"card"sv});
+        return {deserializeCard(fields.at(0, "Missing required field 'card' in PLAY_CARD payload"))};
     }
 
-    InitGamePayload MessageSerializer::deserializeInitGamePayload(const nlohmann::json &payload)
+    InitGamePayload MessageSerializer::deserializeInitGamePayload(std::string_view payload)
     {
-        try {
-            if (payload.is_object() == false) {
-                throw std::invalid_argument("Invalid INIT_GAME payload: expected JSON object");
-            }
-            if (payload.at("player_id").is_number_unsigned() == false) {
-                throw std::invalid_argument("Invalid 'player_id' field in INIT_GAME payload: expected unsigned interger");
-            }
-            if (payload.at("current_player").is_number_unsigned() == false) {
-                throw std::invalid_argument("Invalid 'current_player' field in INIT_GAME payload: expected unsigned integer");
-            }
-            return {payload.at("player_id"),
-                    deserializeClientPlayerStates(payload.at("players")),
-                    deserializeDiscardPile(payload.at("discard_pile")),
-                    deserializeHandCard(payload.at("hand_card")),
-                    payload.at("current_player")};
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid INIT_GAME payload: expected JSON object");
+        }
+        constexpr const char *missing =
+            "Missing required field in INIT_GAME payload: expected 'players', 'discard', 'hand_card', and 'current_player'";
+
+        ObjectFields fields(payload,
+                            std::array{"player_id"sv, "players"sv, "discard"sv, "hand_card"sv, "current_player"sv, "discard_pile"sv});
+        if (isUnsigned(fields.at(0, missing)) == false) {
+            throw std::invalid_argument("Invalid 'player_id' field in INIT_GAME payload: expected unsigned interger");
+        }
+        if (isUnsigned(fields.at(4, missing)) == false) {
+            throw std::invalid_argument("Invalid 'current_player' field in INIT_GAME payload: expected unsigned integer");
+        }
+
+        // 完整的弃牌堆是可选的；只发送完整弃牌堆的旧服务端仍然兼容，摘要由弃牌堆得出
+        std::optional<GAME::DiscardPile> discardPile;
+        if (fields.contains(5)) {
+            discardPile = deserializeDiscardPile(fields.at(5, missing));
+        }
+        GAME::DiscardSummary discardSummary{};
+        if (fields.contains(2)) {
+            discardSummary = deserializeDiscardSummary(fields.at(2, missing));
+        }
+        else if (discardPile.has_value()) {
+            discardSummary = discardPile->getSummary();
         }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument(
-                "Missing required field in INIT_GAME payload: expected 'players', 'discard_pile', 'hand_card', and 'current_player'");
+        else {
+            throw std::invalid_argument(missing);
         }
+
+        return {toUnsigned(fields.at(0, missing)),
+                deserializeClientPlayerStates(fields.at(1, missing)),
+                discardSummary,
+                deserializeHandCard(fields.at(3, missing)),
+                toUnsigned(fields.at(4, missing)),
+                std::move(discardPile)};
     }
 
-    EndGamePayload MessageSerializer::deserializeEndGamePayload(const nlohmann::json &payload)
+    EndGamePayload MessageSerializer::deserializeEndGamePayload(std::string_view payload)
     {
-        if (payload.is_null() == false) {
+        if (typeOf(payload) != COMMON::JsonType::NULL_VALUE) {
             throw std::invalid_argument("Invalid END_GAME payload: expected null");
         }
         return {};
     }
 
-    MessagePayloadType MessageSerializer::deserializeMessagePayloadType(const std::string &messagePayloadType)
+    AckPayload MessageSerializer::deserializeAckPayload(std::string_view payload)
     {
-        if (messagePayloadType == "EMPTY") {
-            return MessagePayloadType::EMPTY;
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid ACK payload: expected JSON object");
         }
-        if (messagePayloadType == "JOIN_GAME") {
-            return MessagePayloadType::JOIN_GAME;
+        constexpr const char *missing = "Missing required field 'sequence' in ACK payload";
+
+        ObjectFields fields(payload, std::array{"sequence"sv});
+        if (isUnsigned(fields.at(0, missing)) == false) {
+            throw std::invalid_argument("Invalid 'sequence' field in ACK payload: expected unsigned integer");
         }
-        if (messagePayloadType == "START_GAME") {
-            return MessagePayloadType::START_GAME;
+        return {toUnsigned(fields.at(0, missing))};
+    }
+
+    SyncRequestPayload MessageSerializer::deserializeSyncRequestPayload(std::string_view payload)
+    {
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid SYNC_REQUEST payload: expected JSON object");
         }
-        if (messagePayloadType == "DRAW_CARD") {
-            return MessagePayloadType::DRAW_CARD;
+        constexpr const char *missing = "Missing required field 'from_sequence' in SYNC_REQUEST payload";
+
+        ObjectFields fields(payload, std::array{"from_sequence"sv});
+        if (isUnsigned(fields.at(0, missing)) == false) {
+            throw std::invalid_argument("Invalid 'from_sequence' field in SYNC_REQUEST payload: expected unsigned integer");
         }
-        if (messagePayloadType == "PLAY_CARD") {
-            return MessagePayloadType::PLAY_CARD;
+        return {toUnsigned(fields.at(0, missing))};
+    }
+
+    SessionPayload MessageSerializer::deserializeSessionPayload(std::string_view payload)
+    {
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid SESSION payload: expected JSON object");
         }
-        if (messagePayloadType == "INIT_GAME") {
-            return MessagePayloadType::INIT_GAME;
+        constexpr const char *missing = "Missing required field 'resume_token' in SESSION payload";
+
+        ObjectFields fields(payload, std::array{"resume_token"sv});
+        if (typeOf(fields.at(0, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid 'resume_token' field in SESSION payload: expected string");
         }
-        if (messagePayloadType == "END_GAME") {
-            return MessagePayloadType::END_GAME;
+        return {toString(fields.at(0, missing))};
+    }
+
+    SyncPayload MessageSerializer::deserializeSyncPayload(std::string_view payload)
+    {
+        if (typeOf(payload) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid SYNC payload: expected JSON object");
+        }
+        constexpr const char *missing = "Missing required field in SYNC payload: expected 'player_id', 'players', 'discard', "
+                                        "'hand_card', 'current_player', 'is_reversed' and 'draw_count'";
+
+        ObjectFields fields(payload,
+                            std::array{"player_id"sv,
+                                       "players"sv,
+                                       "discard"sv,
+                                       "hand_card"sv,
+                                       "current_player"sv,
+                                       "is_reversed"sv,
+                                       "draw_count"sv});
+        if (isUnsigned(fields.at(0, missing)) == false) {
+            throw std::invalid_argument("Invalid 'player_id' field in SYNC payload: expected unsigned integer");
+        }
+        if (isUnsigned(fields.at(4, missing)) == false) {
+            throw std::invalid_argument("Invalid 'current_player' field in SYNC payload: expected unsigned integer");
+        }
+        if (typeOf(fields.at(5, missing)) != COMMON::JsonType::BOOLEAN) {
+            throw std::invalid_argument("Invalid 'is_reversed' field in SYNC payload: expected boolean");
+        }
+        if (isUnsigned(fields.at(6, missing)) == false) {
+            throw std::invalid_argument("Invalid 'draw_count' field in SYNC payload: expected unsigned integer");
+        }
+        return {toUnsigned(fields.at(0, missing)),
+                deserializeClientPlayerStates(fields.at(1, missing)),
+                deserializeDiscardSummary(fields.at(2, missing)),
+                deserializeHandCard(fields.at(3, missing)),
+                toUnsigned(fields.at(4, missing)),
+                COMMON::JsonReader(fields.at(5, missing)).readBool(),
+                toUnsigned(fields.at(6, missing))};
+    }
+
+    MessagePayloadType MessageSerializer::deserializeMessagePayloadType(std::string_view messagePayloadType)
+    {
+        if (auto index = PayloadTypeHash.find(messagePayloadType)) {
+            return static_cast<MessagePayloadType>(*index);
         }
-        throw std::invalid_argument("Invalid message payload type: '" + messagePayloadType
-                                    + "'. Expected: EMPTY, JOIN_GAME, START_GAME, DRAW_CARD, PLAY_CARD, INIT_GAME, or END_GAME");
+        throw std::invalid_argument("Invalid message payload type: '" + std::string(messagePayloadType)
+                                    + "'. Expected: EMPTY, JOIN_GAME, START_GAME, DRAW_CARD, PLAY_CARD, INIT_GAME, END_GAME, ACK, "
+                                      "SYNC_REQUEST, SYNC, or SESSION");
     }
 
-    MessageStatus MessageSerializer::deserializeMessageStatus(const std::string &messageStatus)
+    MessageStatus MessageSerializer::deserializeMessageStatus(std::string_view messageStatus)
     {
         if (messageStatus == "OK") {
             return MessageStatus::OK;
@@ -403,67 +708,232 @@ namespace UNO::NETWORK {
         if (messageStatus == "INVALID") {
             return MessageStatus::INVALID;
         }
-        throw std::invalid_argument("Invalid message status: " + messageStatus + ". Expected: OK, INVALID");
+        throw std::invalid_argument("Invalid message status: " + std::string(messageStatus) + ". Expected: OK, INVALID");
     }
 
-    Message MessageSerializer::deserializeMessage(const nlohmann::json &message)
+    MessageHeader MessageSerializer::deserializeHeader(std::string_view data)
     {
-        try {
-            if (message.is_object() == false) {
-                throw std::invalid_argument("Invalid message format: expected JSON object");
+        // 先校验整个文档的语法，语法错误一律报告为 "Invalid JSON body"，之后的字段解析不会再遇到语法错误
+        COMMON::JsonReader reader(data);
+        auto message = reader.skipValue();
+        reader.expectEnd();
+
+        if (typeOf(message) != COMMON::JsonType::OBJECT) {
+            throw std::invalid_argument("Invalid message format: expected JSON object");
+        }
+        constexpr const char *missing = "Missing required field in message: expected 'status_code', 'payload_type' and 'payload'";
+
+        ObjectFields fields(message, std::array{"status_code"sv, "payload_type"sv, "payload"sv, "sequence"sv});
+        if (typeOf(fields.at(1, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid 'payload_type' field: expected string");
+        }
+        if (typeOf(fields.at(0, missing)) != COMMON::JsonType::STRING) {
+            throw std::invalid_argument("Invalid message: expected string in 'status_code'");
+        }
+
+        // sequence 是可选的，不属于状态流的消息没有这个字段
+        uint64_t sequence = NoSequence;
+        if (fields.contains(3)) {
+            if (isUnsigned(fields.at(3, missing)) == false) {
+                throw std::invalid_argument("Invalid 'sequence' field: expected unsigned integer");
             }
-            if (message.at("payload_type").is_string() == false) {
-                throw std::invalid_argument("Invalid 'payload_type' field: expected string");
+            sequence = toUnsigned(fields.at(3, missing));
+        }
+
+        auto payloadType = deserializeMessagePayloadType(toString(fields.at(1, missing)));
+        auto status      = deserializeMessageStatus(toString(fields.at(0, missing)));
+        return {status, payloadType, sequence, fields.at(2, missing)};
+    }
+
+    MessagePayload MessageSerializer::deserializePayload(MessagePayloadType payloadType, std::string_view payload)
+    {
+        switch (payloadType) {
+            case MessagePayloadType::EMPTY: return deserializeEmptyPayload(payload);
+            case MessagePayloadType::JOIN_GAME: return deserializeJoinGamePayload(payload);
+            case MessagePayloadType::START_GAME: return deserializeStartGamePayload(payload);
+            case MessagePayloadType::DRAW_CARD: return deserializeDrawCardPayload(payload);
+            case MessagePayloadType::PLAY_CARD: return deserializePlayCardPayload(payload);
+            case MessagePayloadType::INIT_GAME: return deserializeInitGamePayload(payload);
+            case MessagePayloadType::END_GAME: return deserializeEndGamePayload(payload);
+            case MessagePayloadType::ACK: return deserializeAckPayload(payload);
+            case MessagePayloadType::SYNC_REQUEST: return deserializeSyncRequestPayload(payload);
+            case MessagePayloadType::SYNC: return deserializeSyncPayload(payload);
+            case MessagePayloadType::SESSION: return deserializeSessionPayload(payload);
+        }
+
+        std::unreachable();
+    }
+
+    MessageEncoding MessageSerializer::detectEncoding(std::string_view data)
+    {
+        if (data.empty() == false
+            && (static_cast<uint8_t>(data.front()) == BinaryMessageSerializer::FrameTag
+                || static_cast<uint8_t>(data.front()) == BinaryMessageSerializer::SequencedFrameTag)) {
+            return MessageEncoding::BINARY;
+        }
+        return MessageEncoding::JSON;
+    }
+
+    Message MessageSerializer::deserialize(const std::string &data)
+    {
+        return MessageView(data).decode();
+    }
+
+    namespace {
+        constexpr std::array AllEncodings = {MessageEncoding::JSON, MessageEncoding::BINARY};
+
+        /**
+         * 每种编码下所有形状固定的消息
+         */
+        struct EncodedFrames {
+            std::array<std::shared_ptr<const std::string>, GAME::AllColors.size() * GAME::AllTypes.size()> playCard;
+            std::array<std::shared_ptr<const std::string>, MessageSerializer::MaxCachedDrawCount> drawCount;
+            std::shared_ptr<const std::string> startGame;
+            std::shared_ptr<const std::string> endGame;
+            std::shared_ptr<const std::string> invalid;
+        };
+
+        std::shared_ptr<const std::string> encode(const Message &message, MessageEncoding encoding)
+        {
+            return std::make_shared<const std::string>(MessageSerializer::serialize(message, encoding));
+        }
+
+        size_t cardIndex(const GAME::Card &card)
+        {
+            auto color = static_cast<size_t>(std::to_underlying(card.getColor()));
+            auto type  = static_cast<size_t>(std::to_underlying(card.getType()));
+            if (color >= GAME::AllColors.size() || type >= GAME::AllTypes.size()) {
+                throw std::invalid_argument("Invalid card: no cached frame");
             }
-            if (message.at("status_code").is_string() == false) {
-                throw std::invalid_argument("Invalid message: expected string in 'status_code'");
+            return color * GAME::AllTypes.size() + type;
+        }
+
+        EncodedFrames buildFrames(MessageEncoding encoding)
+        {
+            EncodedFrames frames;
+            for (auto color : GAME::AllColors) {
+                for (auto type : GAME::AllTypes) {
+                    GAME::Card card(color, type);
+                    frames.playCard[cardIndex(card)] =
+                        encode({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{card}}, encoding);
+                }
             }
-
-            auto payloadType = deserializeMessagePayloadType(message.at("payload_type"));
-            switch (payloadType) {
-                case MessagePayloadType::EMPTY:
-                    return {
-                        deserializeMessageStatus(message.at("status_code")), payloadType, deserializeEmptyPayload(message.at("payload"))};
-                case MessagePayloadType::JOIN_GAME:
-                    return {deserializeMessageStatus(message.at("status_code")),
-                            payloadType,
-                            deserializeJoinGamePayload(message.at("payload"))};
-                case MessagePayloadType::START_GAME:
-                    return {deserializeMessageStatus(message.at("status_code")),
-                            payloadType,
-                            deserializeStartGamePayload(message.at("payload"))};
-                case MessagePayloadType::DRAW_CARD:
-                    return {deserializeMessageStatus(message.at("status_code")),
-                            payloadType,
-                            deserializeDrawCardPayload(message.at("payload"))};
-                case MessagePayloadType::PLAY_CARD:
-                    return {deserializeMessageStatus(message.at("status_code")),
-                            payloadType,
-                            deserializePlayCardPayload(message.at("payload"))};
-                case MessagePayloadType::INIT_GAME:
-                    return {deserializeMessageStatus(message.at("status_code")),
-                            payloadType,
-                            deserializeInitGamePayload(message.at("payload"))};
-                case MessagePayloadType::END_GAME:
-                    return {
-                        deserializeMessageStatus(message.at("status_code")), payloadType, deserializeEndGamePayload(message.at("payload"))};
+            for (size_t count = 1; count <= MessageSerializer::MaxCachedDrawCount; count++) {
+                frames.drawCount[count - 1] =
+                    encode({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{count, {}}}, encoding);
             }
+            frames.startGame = encode({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}}, encoding);
+            frames.endGame   = encode({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}}, encoding);
+            frames.invalid   = encode({MessageStatus::INVALID, MessagePayloadType::EMPTY, std::monostate{}}, encoding);
+            return frames;
+        }
 
-            std::unreachable();
+        const EncodedFrames &framesFor(MessageEncoding encoding)
+        {
+            // 局部静态变量的初始化是线程安全的，缓存在首次使用时构建且之后只读
+            static const auto cache = []() {
+                std::array<EncodedFrames, AllEncodings.size()> result;
+                for (auto encoding : AllEncodings) {
+                    result[std::to_underlying(encoding)] = buildFrames(encoding);
+                }
+                return result;
+            }();
+            return cache[std::to_underlying(encoding)];
         }
-        catch (const nlohmann::json::out_of_range &) {
-            throw std::invalid_argument("Missing required field in message: expected 'status_code', 'payload_type' and 'payload'");
+    }   // namespace
+
+    const std::shared_ptr<const std::string> &MessageSerializer::playCardFrame(const GAME::Card &card, MessageEncoding encoding)
+    {
+        return framesFor(encoding).playCard[cardIndex(card)];
+    }
+
+    const std::shared_ptr<const std::string> &MessageSerializer::drawCountFrame(size_t count, MessageEncoding encoding)
+    {
+        if (count == 0 || count > MaxCachedDrawCount) {
+            throw std::invalid_argument("Draw count out of cached range");
         }
+        return framesFor(encoding).drawCount[count - 1];
     }
 
-    Message MessageSerializer::deserialize(const std::string &data)
+    const std::shared_ptr<const std::string> &MessageSerializer::startGameFrame(MessageEncoding encoding)
+    {
+        return framesFor(encoding).startGame;
+    }
+
+    const std::shared_ptr<const std::string> &MessageSerializer::endGameFrame(MessageEncoding encoding)
+    {
+        return framesFor(encoding).endGame;
+    }
+
+    const std::shared_ptr<const std::string> &MessageSerializer::invalidFrame(MessageEncoding encoding)
+    {
+        return framesFor(encoding).invalid;
+    }
+
+    std::string MessageSerializer::addSequence(std::string_view frame, uint64_t sequence, MessageEncoding encoding)
     {
-        try {
-            return deserializeMessage(nlohmann::json::parse(data));
+        if (sequence == NoSequence) {
+            return std::string(frame);
+        }
+
+        if (encoding == MessageEncoding::BINARY) {
+            COMMON::BinaryWriter writer;
+            writer.writeByte(BinaryMessageSerializer::SequencedFrameTag);
+            writer.writeVarint(sequence);
+            auto result = writer.release();
+            result.append(frame.substr(1));
+            return result;
         }
-        catch (const nlohmann::json::parse_error &) {
-            throw std::invalid_argument("Invalid JSON body");
+
+        // 顶层的键按字典序排列，sequence 位于最后一个键 status_code 之前；负载中的引号都经过转义，
+        // 因此最后一次出现的 ,"status_code": 一定属于顶层对象
+        auto position = frame.rfind(",\"status_code\":");
+        if (position == std::string_view::npos) {
+            throw std::invalid_argument("Invalid JSON frame: missing 'status_code' field");
         }
+        std::string result;
+        result.reserve(frame.size() + 32);
+        result.append(frame.substr(0, position));
+        result.append(",\"sequence\":");
+        result.append(std::to_string(sequence));
+        result.append(frame.substr(position));
+        return result;
+    }
+
+    std::shared_ptr<const std::string> MessageSerializer::findCachedFrame(const Message &message, MessageEncoding encoding)
+    {
+        if (message.getMessageStatus() != MessageStatus::OK) {
+            return nullptr;
+        }
+
+        std::shared_ptr<const std::string> frame;
+        switch (message.getMessagePayloadType()) {
+            case MessagePayloadType::PLAY_CARD:
+                frame = playCardFrame(std::get<PlayCardPayload>(message.getMessagePayload()).card, encoding);
+                break;
+            case MessagePayloadType::DRAW_CARD: {
+                const auto &payload = std::get<DrawCardPayload>(message.getMessagePayload());
+                if (payload.cards.empty() && payload.drawCount >= 1 && payload.drawCount <= MaxCachedDrawCount) {
+                    frame = drawCountFrame(payload.drawCount, encoding);
+                }
+                break;
+            }
+            case MessagePayloadType::START_GAME: frame = startGameFrame(encoding); break;
+            case MessagePayloadType::END_GAME: frame = endGameFrame(encoding); break;
+            case MessagePayloadType::EMPTY:
+            case MessagePayloadType::JOIN_GAME:
+            case MessagePayloadType::INIT_GAME:
+            case MessagePayloadType::ACK:
+            case MessagePayloadType::SYNC_REQUEST:
+            case MessagePayloadType::SYNC:
+            case MessagePayloadType::SESSION: return nullptr;
+        }
+
+        // 缓存的帧不带序号，属于状态流的消息只需在缓存的帧上补写序号，仍然省去了负载的序列化
+        if (frame == nullptr || message.getSequence() == NoSequence) {
+            return frame;
+        }
+        return std::make_shared<const std::string>(addSequence(*frame, message.getSequence(), encoding));
     }
 
 }   // namespace UNO::NETWORK
@@ -5,61 +5,190 @@
  * @date 2025.11.20
  */
 #pragma once
+#include "../common/JsonReader.h"
+#include "../common/JsonWriter.h"
 #include "Message.h"
 
-#include <nlohmann/json.hpp>
+#include <memory>
 #include <string>
+#include <string_view>
 
 namespace UNO::NETWORK {
 
+    /**
+     * 消息的线上编码
+     */
+    enum class MessageEncoding {
+        /**
+         * 可读的 JSON 文本，便于调试
+         */
+        JSON,
+        /**
+         * 紧凑二进制编码，见 BinaryMessageSerializer
+         */
+        BINARY
+    };
+
     class MessageSerializer {
     public:
-        static std::string serialize(const Message &message);
+        /**
+         * 序列化消息
+         * @param message 要序列化的消息
+         * @param encoding 使用的编码
+         * @return 序列化后的数据
+         */
+        static std::string serialize(const Message &message, MessageEncoding encoding = MessageEncoding::JSON);
+
+        /**
+         * 序列化消息到已有的缓冲区，缓冲区原有内容被替换，容量得以复用
+         * @param message 要序列化的消息
+         * @param buffer 输出缓冲区
+         * @param encoding 使用的编码
+         */
+        static void serialize(const Message &message, std::string &buffer, MessageEncoding encoding = MessageEncoding::JSON);
+
+        /**
+         * 反序列化消息，编码由数据本身判断
+         * @param data 序列化后的数据
+         * @return 消息
+         */
         static Message deserialize(const std::string &data);
 
+        /**
+         * 校验 JSON 消息的语法并只解码 status_code 与 payload_type
+         * @param data JSON 文本
+         * @return 消息头，负载指向 data 内部
+         */
+        static MessageHeader deserializeHeader(std::string_view data);
+
+        /**
+         * 解码 JSON 负载
+         * @param payloadType 负载类型
+         * @param payload 负载的原始 JSON 文本
+         * @return 负载
+         */
+        static MessagePayload deserializePayload(MessagePayloadType payloadType, std::string_view payload);
+
+        /**
+         * @param data 序列化后的数据
+         * @return 数据使用的编码
+         */
+        static MessageEncoding detectEncoding(std::string_view data);
+
+        // 形状固定的消息只取决于很小的键，首次使用时按每种编码预先序列化，之后发送只需查表；
+        // 帧存放在共享缓冲区中，可以直接交给 Session 发送给任意多个玩家而不复制
+
+        /**
+         * 预先序列化的非摸牌者 DRAW_CARD 帧覆盖的最大摸牌数，更多的摸牌数需要即时序列化
+         */
+        static constexpr size_t MaxCachedDrawCount = 32;
+
+        /**
+         * @param card 打出的牌
+         * @param encoding 使用的编码
+         * @return 预先序列化的 PLAY_CARD 消息
+         */
+        static const std::shared_ptr<const std::string> &playCardFrame(const GAME::Card &card, MessageEncoding encoding);
+
+        /**
+         * @param count 摸牌数，范围为 [1, MaxCachedDrawCount]
+         * @param encoding 使用的编码
+         * @return 预先序列化的只含摸牌数、不含牌面的 DRAW_CARD 消息
+         */
+        static const std::shared_ptr<const std::string> &drawCountFrame(size_t count, MessageEncoding encoding);
+
+        /**
+         * @param encoding 使用的编码
+         * @return 预先序列化的 START_GAME 消息
+         */
+        static const std::shared_ptr<const std::string> &startGameFrame(MessageEncoding encoding);
+
+        /**
+         * @param encoding 使用的编码
+         * @return 预先序列化的 END_GAME 消息
+         */
+        static const std::shared_ptr<const std::string> &endGameFrame(MessageEncoding encoding);
+
+        /**
+         * @param encoding 使用的编码
+         * @return 预先序列化的 INVALID 消息，服务端拒绝玩家消息时回复
+         */
+        static const std::shared_ptr<const std::string> &invalidFrame(MessageEncoding encoding);
+
+        /**
+         * 查找与消息相同的预先序列化的帧
+         * @param message 消息
+         * @param encoding 使用的编码
+         * @return 预先序列化的帧，消息没有对应的帧时为 nullptr
+         */
+        static std::shared_ptr<const std::string> findCachedFrame(const Message &message, MessageEncoding encoding);
+
+        /**
+         * 为不带序号的帧补写序号，结果与直接序列化带序号的消息相同
+         * @param frame 不带序号的帧
+         * @param sequence 序号
+         * @param encoding 帧使用的编码
+         * @return 带序号的帧
+         */
+        static std::string addSequence(std::string_view frame, uint64_t sequence, MessageEncoding encoding);
+
+        /**
+         * @param messagePayloadType 负载类型
+         * @return JSON 中使用的负载类型名，例如 PLAY_CARD
+         */
+        static std::string_view serializeMessagePayloadType(const MessagePayloadType &messagePayloadType);
+
     private:
-        static nlohmann::json serializeCard(const GAME::Card &card);
+        static void serializeCard(COMMON::JsonWriter &writer, const GAME::Card &card);
 
         template<typename Iterator>
-        static nlohmann::json serializeCards(Iterator begin, Iterator end);
-
-        static nlohmann::json serializeDiscardPile(const GAME::DiscardPile &discardPile);
-        static nlohmann::json serializeClientPlayerState(const GAME::ClientPlayerState &state);
-        static nlohmann::json serializeClientPlayerStates(const std::vector<GAME::ClientPlayerState> &states);
-
-        static nlohmann::json serializePayload(const std::monostate &payload);
-        static nlohmann::json serializePayload(const JoinGamePayload &payload);
-        static nlohmann::json serializePayload(const StartGamePayload &payload);
-        static nlohmann::json serializePayload(const PlayCardPayload &payload);
-        static nlohmann::json serializePayload(const DrawCardPayload &payload);
-        static nlohmann::json serializePayload(const InitGamePayload &payload);
-        static nlohmann::json serializePayload(const EndGamePayload &payload);
-
-        static std::string serializeMessagePayloadType(const MessagePayloadType &messagePayloadType);
-        static std::string serializeMessageStatus(const MessageStatus &messageStatus);
-
-        static nlohmann::json serializeMessage(const Message &message);
-
-        static GAME::CardColor deserializeCardColor(const std::string &cardColor);
-        static GAME::CardType deserializeCardType(const std::string &cardType);
-        static GAME::Card deserializeCard(const nlohmann::json &card);
-        static GAME::DiscardPile deserializeDiscardPile(const nlohmann::json &discardPile);
-        static std::multiset<GAME::Card> deserializeHandCard(const nlohmann::json &handCard);
-        static GAME::ClientPlayerState deserializeClientPlayerState(const nlohmann::json &payload);
-        static std::vector<GAME::ClientPlayerState> deserializeClientPlayerStates(const nlohmann::json &payload);
-
-        static std::monostate deserializeEmptyPayload(const nlohmann::json &payload);
-        static JoinGamePayload deserializeJoinGamePayload(const nlohmann::json &payload);
-        static StartGamePayload deserializeStartGamePayload(const nlohmann::json &payload);
-        static PlayCardPayload deserializePlayCardPayload(const nlohmann::json &payload);
-        static DrawCardPayload deserializeDrawCardPayload(const nlohmann::json &payload);
-        static InitGamePayload deserializeInitGamePayload(const nlohmann::json &payload);
-        static EndGamePayload deserializeEndGamePayload(const nlohmann::json &payload);
-
-        static MessagePayloadType deserializeMessagePayloadType(const std::string &messagePayloadType);
-        static MessageStatus deserializeMessageStatus(const std::string &messageStatus);
-
-        static Message deserializeMessage(const nlohmann::json &message);
+        static void serializeCards(COMMON::JsonWriter &writer, Iterator begin, Iterator end);
+
+        static void serializeClientPlayerState(COMMON::JsonWriter &writer, const GAME::ClientPlayerState &state);
+
+        static void serializeDiscardSummary(COMMON::JsonWriter &writer, const GAME::DiscardSummary &summary);
+
+        static void serializePayload(COMMON::JsonWriter &writer, const std::monostate &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const JoinGamePayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const StartGamePayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const PlayCardPayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const DrawCardPayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const InitGamePayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const EndGamePayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const AckPayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const SyncRequestPayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const SyncPayload &payload);
+        static void serializePayload(COMMON::JsonWriter &writer, const SessionPayload &payload);
+
+        static std::string_view serializeMessageStatus(const MessageStatus &messageStatus);
+
+        static void serializeMessage(COMMON::JsonWriter &writer, const Message &message);
+
+        // 反序列化函数的参数是对应 JSON 值的原始文本，整条消息的语法已在 deserialize 中校验过
+
+        static GAME::CardColor deserializeCardColor(std::string_view cardColor);
+        static GAME::CardType deserializeCardType(std::string_view cardType);
+        static GAME::Card deserializeCard(std::string_view card);
+        static GAME::DiscardPile deserializeDiscardPile(std::string_view discardPile);
+        static GAME::DiscardSummary deserializeDiscardSummary(std::string_view discardSummary);
+        static std::multiset<GAME::Card> deserializeHandCard(std::string_view handCard);
+        static GAME::ClientPlayerState deserializeClientPlayerState(std::string_view payload);
+        static std::vector<GAME::ClientPlayerState> deserializeClientPlayerStates(std::string_view payload);
+
+        static std::monostate deserializeEmptyPayload(std::string_view payload);
+        static JoinGamePayload deserializeJoinGamePayload(std::string_view payload);
+        static StartGamePayload deserializeStartGamePayload(std::string_view payload);
+        static PlayCardPayload deserializePlayCardPayload(std::string_view payload);
+        static DrawCardPayload deserializeDrawCardPayload(std::string_view payload);
+        static InitGamePayload deserializeInitGamePayload(std::string_view payload);
+        static EndGamePayload deserializeEndGamePayload(std::string_view payload);
+        static AckPayload deserializeAckPayload(std::string_view payload);
+        static SyncRequestPayload deserializeSyncRequestPayload(std::string_view payload);
+        static SyncPayload deserializeSyncPayload(std::string_view payload);
+        static SessionPayload deserializeSessionPayload(std::string_view payload);
+
+        static MessagePayloadType deserializeMessagePayloadType(std::string_view messagePayloadType);
+        static MessageStatus deserializeMessageStatus(std::string_view messageStatus);
     };
 
 }   // namespace UNO::NETWORK
@@ -0,0 +1,46 @@
+/**
+ * @file MessageView.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.16
+ */
+#include "MessageView.h"
+
+#include "BinaryMessageSerializer.h"
+
+namespace UNO::NETWORK {
+    MessageView::MessageView(std::string_view data) :
+        encoding_(MessageSerializer::detectEncoding(data)),
+        header_(encoding_ == MessageEncoding::BINARY ? BinaryMessageSerializer::deserializeHeader(data)
+                                                     : MessageSerializer::deserializeHeader(data))
+    {
+    }
+
+    MessageStatus MessageView::getMessageStatus() const
+    {
+        return this->header_.status;
+    }
+
+    MessagePayloadType MessageView::getMessagePayloadType() const
+    {
+        return this->header_.payloadType;
+    }
+
+    uint64_t MessageView::getSequence() const
+    {
+        return this->header_.sequence;
+    }
+
+    MessageEncoding MessageView::getEncoding() const
+    {
+        return this->encoding_;
+    }
+
+    Message MessageView::decode() const
+    {
+        auto payload = this->encoding_ == MessageEncoding::BINARY
+                           ? BinaryMessageSerializer::deserializePayload(this->header_.payloadType, this->header_.payload)
+                           : MessageSerializer::deserializePayload(this->header_.payloadType, this->header_.payload);
+        return {this->header_.status, this->header_.payloadType, std::move(payload), this->header_.sequence};
+    }
+}   // namespace UNO::NETWORK
@@ -0,0 +1,46 @@
+/**
+ * @file MessageView.h
+ *
+ * 按类型优先的方式读取收到的消息
+ *
+ * 构造时只解码状态与负载类型，负载在调用 decode 时才从原始数据中解码，
+ * 使得调用方可以在解码负载之前根据类型拒绝消息
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.16
+ */
+#pragma once
+#include "Message.h"
+#include "MessageSerializer.h"
+
+#include <string_view>
+
+namespace UNO::NETWORK {
+
+    class MessageView {
+    private:
+        MessageEncoding encoding_;
+        MessageHeader header_;
+
+    public:
+        /**
+         * 解码消息头，不解码负载
+         *
+         * 视图不持有数据，data 必须在视图使用期间保持有效
+         * @param data 序列化后的数据，编码由数据本身判断
+         */
+        explicit MessageView(std::string_view data);
+
+        [[nodiscard]] MessageStatus getMessageStatus() const;
+        [[nodiscard]] MessagePayloadType getMessagePayloadType() const;
+        [[nodiscard]] uint64_t getSequence() const;
+        [[nodiscard]] MessageEncoding getEncoding() const;
+
+        /**
+         * 解码负载并构造完整的消息
+         * @return 消息
+         */
+        Message decode() const;
+    };
+
+}   // namespace UNO::NETWORK
@@ -12,37 +12,95 @@
 #include <utility>
 
 namespace UNO::NETWORK {
-    NetworkClient::NetworkClient(std::function<void()> onConnect, std::function<void(std::string)> callback) :
-        onConnected_(std::move(onConnect)), callback_(std::move(callback)), workGuard_(asio::make_work_guard(io_context_))
+    NetworkClient::NetworkClient(std::function<void()> onConnect,
+                                 std::function<void(std::string)> callback,
+                                 std::function<void()> onDisconnected,
+                                 std::function<void()> onConnectFailed) :
+        onConnected_(std::move(onConnect)), callback_(std::move(callback)), onDisconnected_(std::move(onDisconnected)),
+        onConnectFailed_(std::move(onConnectFailed)), port_(0), workGuard_(asio::make_work_guard(io_context_))
     {
     }
 
     void NetworkClient::connect(const std::string &host, uint16_t port)
     {
-        auto socket   = std::make_shared<asio::ip::tcp::socket>(io_context_);
-        auto resolver = std::make_shared<asio::ip::tcp::resolver>(io_context_);
-        resolver->async_resolve(host,
-                                std::to_string(port),
-                                [this, resolver, socket](const asio::error_code &ec, const asio::ip::tcp::resolver::results_type &results) {
-                                    if (!ec) {
-                                        asio::async_connect(
-                                            *socket, results, [this, socket](const asio::error_code &ec, const asio::ip::tcp::endpoint &) {
-                                                if (!ec) {
-                                                    this->session_ = std::make_shared<Session>(std::move(*socket));
-                                                    this->session_->start(callback_);
-                                                    this->onConnected_();
-                                                }
-                                            });
-                                    }
-                                });
+        asio::co_spawn(io_context_, this->doConnect(host, port), [this](const std::exception_ptr &, bool isConnected) {
+            if (isConnected == false) {
+                this->handleConnectFailed();
+            }
+        });
     }
 
+    void NetworkClient::reconnect()
+    {
+        asio::co_spawn(io_context_, this->doReconnect(), asio::detached);
+    }
+
+    asio::awaitable<bool> NetworkClient::doConnect(std::string host, uint16_t port)
+    {
+        asio::error_code ec;
+        asio::ip::tcp::resolver resolver(io_context_);
+        auto results = co_await resolver.async_resolve(host, std::to_string(port), asio::redirect_error(asio::use_awaitable, ec));
+        if (ec) {
+            co_return false;
+        }
+
+        asio::ip::tcp::socket socket(io_context_);
+        co_await asio::async_connect(socket, results, asio::redirect_error(asio::use_awaitable, ec));
+        if (ec) {
+            co_return false;
+        }
+
+        this->host_    = std::move(host);
+        this->port_    = port;
+        this->session_ = std::make_shared<Session>(std::move(socket));
+        // 只有当前的连接断开才通知，已经被替换的旧连接稍后结束时不再触发重连
+        this->session_->start(callback_, [this, session = this->session_.get()]() {
+            if (session == this->session_.get() && this->onDisconnected_) {
+                this->onDisconnected_();
+            }
+        });
+        this->onConnected_();
+        co_return true;
+    }
+
+    asio::awaitable<void> NetworkClient::doReconnect()
+    {
+        asio::steady_timer timer(io_context_);
+        auto delay = ReconnectDelay;
+        for (size_t attempt = 0; attempt < MaxReconnectAttempts; attempt++) {
+            asio::error_code ec;
+            timer.expires_after(delay);
+            co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            if (co_await this->doConnect(this->host_, this->port_)) {
+                co_return;
+            }
+            delay *= 2;
+        }
+        this->handleConnectFailed();
+    }
+
+    void NetworkClient::handleConnectFailed()
+    {
+        if (this->onConnectFailed_) {
+            this->onConnectFailed_();
+        }
+    }
 
     void NetworkClient::send(const std::string &message)
     {
         asio::post(io_context_, [session = this->session_, message]() { session->send(message); });
     }
 
+    void NetworkClient::send(std::shared_ptr<const std::string> message)
+    {
+        asio::post(io_context_, [session = this->session_, message = std::move(message)]() { session->send(message); });
+    }
+
+    void NetworkClient::post(std::function<void()> task)
+    {
+        asio::post(io_context_, std::move(task));
+    }
+
     void NetworkClient::run()
     {
         this->io_context_.run();
@@ -8,6 +8,7 @@
 #include "Session.h"
 
 #include <asio/io_context.hpp>
+#include <chrono>
 
 namespace UNO::NETWORK {
 
@@ -18,25 +19,78 @@ namespace UNO::NETWORK {
 
         std::function<void()> onConnected_;
         std::function<void(std::string)> callback_;
+        std::function<void()> onDisconnected_;
+        std::function<void()> onConnectFailed_;
 
         std::shared_ptr<Session> session_;
 
+        /**
+         * 最近一次连接的服务端地址，重连时使用
+         */
+        std::string host_;
+        uint16_t port_;
+
+    private:
+        /**
+         * @return 是否连接成功
+         */
+        asio::awaitable<bool> doConnect(std::string host, uint16_t port);
+        asio::awaitable<void> doReconnect();
+
+        void handleConnectFailed();
+
     public:
-        NetworkClient(std::function<void()> onConnect, std::function<void(std::string)> callback);
+        /**
+         * 重连的最大尝试次数
+         */
+        static constexpr size_t MaxReconnectAttempts = 10;
+
+        /**
+         * 第一次重连前的等待时间，之后每次加倍
+         */
+        static constexpr std::chrono::milliseconds ReconnectDelay{100};
 
         /**
-         * 连接到服务端
+         * @param onConnect 连接成功时调用，重连成功时也会调用
+         * @param callback 收到消息时调用
+         * @param onDisconnected 连接断开时调用，可以为空
+         * @param onConnectFailed 连接失败或重连次数用尽、不会再尝试时调用，可以为空
+         */
+        NetworkClient(std::function<void()> onConnect,
+                      std::function<void(std::string)> callback,
+                      std::function<void()> onDisconnected  = {},
+                      std::function<void()> onConnectFailed = {});
+
+        /**
+         * 连接到服务端，失败时不重试
          * @param host 服务端地址
          * @param port 服务端端口
          */
         void connect(const std::string &host, uint16_t port);
 
+        /**
+         * 断线后重新连接到最近一次连接的服务端，失败时按指数退避重试
+         */
+        void reconnect();
+
         /**
          * 向服务端发送消息
          * @param message 要发送的消息
          */
         void send(const std::string &message);
 
+        /**
+         * 向服务端发送共享缓冲区中的消息，不复制消息内容
+         * @param message 要发送的消息
+         */
+        void send(std::shared_ptr<const std::string> message);
+
+        /**
+         * 在网络线程上执行任务，任务与收到消息的回调不会并发执行
+         * @param task 要执行的任务
+         */
+        void post(std::function<void()> task);
+
         /**
          * 启动网络事件循环
          */
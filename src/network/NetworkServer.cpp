@@ -19,8 +19,12 @@ namespace UNO::NETWORK {
         });
     }
 
-    NetworkServer::NetworkServer(uint16_t port, std::function<void(size_t, std::string)> callback) :
-        acceptor_(io_context_, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)), playerCount(0), callback_(std::move(callback))
+    NetworkServer::NetworkServer(uint16_t port, std::function<void(size_t, std::string)> callback, const SessionLimits &limits) :
+        acceptor_(io_context_, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port)),
+        playerCount(0),
+        callback_(std::move(callback)),
+        limits_(limits),
+        sessionStats_(std::make_shared<SessionStats>())
     {
         accept();
     }
@@ -29,18 +33,62 @@ namespace UNO::NETWORK {
     {
         std::lock_guard<std::mutex> lock(this->mutex_);
         size_t playerId           = this->playerCount;
-        this->sessions_[playerId] = std::make_shared<Session>(std::move(socket));
-        this->sessions_[playerId]->start([this, playerId](std::string message) { this->callback_(playerId, std::move(message)); });
+        auto session              = std::make_shared<Session>(std::move(socket), this->limits_, this->sessionStats_);
+        this->sessions_[playerId] = session;
+        // 连接断开时从表中移除；id 不会复用，removePlayer 已经移除时这里什么也不做
+        auto onClose = [this, playerId]() {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->sessions_.erase(playerId);
+        };
+        session->start([this, playerId](std::string message) { this->callback_(playerId, std::move(message)); }, onClose);
         this->playerCount++;
     }
 
+    void NetworkServer::removePlayer(size_t id)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        auto it = this->sessions_.find(id);
+        if (it == this->sessions_.end()) {
+            return;
+        }
+        it->second->close();
+        this->sessions_.erase(it);
+    }
+
+    bool NetworkServer::hasPlayer(size_t id)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        return this->sessions_.contains(id);
+    }
+
     void NetworkServer::send(size_t id, const std::string &message)
     {
         std::lock_guard<std::mutex> lock(this->mutex_);
-        if (this->sessions_.contains(id) == false) {
-            throw std::invalid_argument("Player session not found");
+        auto it = this->sessions_.find(id);
+        if (it == this->sessions_.end()) {
+            return;
+        }
+        it->second->send(message);
+    }
+
+    void NetworkServer::send(size_t id, std::shared_ptr<const std::string> message, std::shared_ptr<void> completion)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        auto it = this->sessions_.find(id);
+        if (it == this->sessions_.end()) {
+            return;
         }
-        this->sessions_[id]->send(message);
+        it->second->send(std::move(message), std::move(completion));
+    }
+
+    uint16_t NetworkServer::getPort() const
+    {
+        return this->acceptor_.local_endpoint().port();
+    }
+
+    const SessionStats &NetworkServer::getSessionStats() const
+    {
+        return *this->sessionStats_;
     }
 
     void NetworkServer::run()
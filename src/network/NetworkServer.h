@@ -23,22 +23,60 @@ namespace UNO::NETWORK {
         std::function<void(size_t, std::string)> callback_;
         std::mutex mutex_;
 
+        SessionLimits limits_;
+        std::shared_ptr<SessionStats> sessionStats_;
+
     public:
-        explicit NetworkServer(uint16_t port, std::function<void(size_t, std::string)> callback);
+        /**
+         * @param port 监听的端口
+         * @param callback 收到玩家消息时调用
+         * @param limits 每个玩家连接的限速配置，默认不限速
+         */
+        explicit NetworkServer(uint16_t port, std::function<void(size_t, std::string)> callback, const SessionLimits &limits = {});
 
         /**
-         * 添加玩家
+         * 添加玩家，连接断开后自动移除
          * @param socket 玩家的连接 socket
          */
         void addPlayer(asio::ip::tcp::socket socket);
 
         /**
-         * 向玩家发送消息
+         * 关闭并移除玩家的连接，玩家重连到新的连接后旧的连接不再使用
+         * @param id 要移除的玩家 id
+         */
+        void removePlayer(size_t id);
+
+        /**
+         * @param id 玩家 id
+         * @return 玩家的连接是否仍然存在
+         */
+        [[nodiscard]] bool hasPlayer(size_t id);
+
+        /**
+         * 向玩家发送消息，玩家的连接已经断开或被移除时丢弃消息
          * @param id 要发送到的玩家 id
          * @param message 要发送的消息
          */
         void send(size_t id, const std::string &message);
 
+        /**
+         * 向玩家发送共享缓冲区中的消息，同一条消息发给多个玩家时只需一份缓冲区；玩家的连接已经断开或被移除时丢弃消息
+         * @param id 要发送到的玩家 id
+         * @param message 要发送的消息
+         * @param completion 消息写入 socket 后释放的对象，可以为空
+         */
+        void send(size_t id, std::shared_ptr<const std::string> message, std::shared_ptr<void> completion = nullptr);
+
+        /**
+         * @return 实际监听的端口，构造时传入 0 则由系统分配
+         */
+        [[nodiscard]] uint16_t getPort() const;
+
+        /**
+         * @return 所有玩家连接的统计
+         */
+        [[nodiscard]] const SessionStats &getSessionStats() const;
+
         /**
          * 开始网络进程
          */
@@ -6,67 +6,188 @@
  */
 #include "Session.h"
 
+#include "../common/Trace.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 namespace UNO::NETWORK {
-    Session::Session(asio::ip::tcp::socket socket) : socket_(std::move(socket)) {}
+    namespace {
+        /**
+         * awaitable 完成令牌：处理器从 memory 分配，错误写入 ec 而不是抛出
+         */
+        auto sessionToken(HandlerMemory &memory, asio::error_code &ec)
+        {
+            return asio::bind_allocator(HandlerAllocator<std::byte>(memory),
+                                        asio::redirect_error(asio::use_awaitable_t<SessionExecutor>(), ec));
+        }
+
+        SessionExecutor toSessionExecutor(const asio::any_io_executor &executor)
+        {
+            const auto *target = executor.target<SessionExecutor>();
+            if (target == nullptr) {
+                throw std::invalid_argument("Session socket must be bound to an io_context executor");
+            }
+            return *target;
+        }
 
-    void Session::start(std::function<void(std::string)> callback)
+        thread_local std::chrono::steady_clock::time_point currentDispatchTime;
+    }   // namespace
+
+    Session::Session(asio::ip::tcp::socket socket, const SessionLimits &limits, std::shared_ptr<SessionStats> stats) :
+        socket_(std::move(socket)),
+        executor_(toSessionExecutor(socket_.get_executor())),
+        writeSignal_(socket_.get_executor()),
+        readLength_(0),
+        writeLength_(0),
+        readTraceId_(COMMON::Tracer::newAsyncId()),
+        writeTraceId_(COMMON::Tracer::newAsyncId()),
+        messageBucket_(limits.messagesPerSecond, limits.messageBurst),
+        byteBucket_(limits.bytesPerSecond, limits.byteBurst),
+        throttleBudget_(std::chrono::duration<double>(limits.maxThrottleDelay) / limits.throttleWindow,
+                        std::chrono::duration<double>(limits.maxThrottleDelay).count()),
+        throttleTimer_(socket_.get_executor()),
+        stats_(std::move(stats))
+    {
+        // 每条消息都很小且需要立即送达，关闭 Nagle 算法，避免与对端的延迟确认叠加成数十毫秒的停顿
+        asio::error_code ec;
+        this->socket_.set_option(asio::ip::tcp::no_delay(true), ec);
+        this->writeSignal_.expires_at(asio::steady_timer::time_point::max());
+    }
+
+    void Session::start(std::function<void(std::string)> callback, std::function<void()> onClose)
     {
         this->callback_ = std::move(callback);
-        this->doRead();
+        this->onClose_  = std::move(onClose);
+        if (this->stats_ != nullptr) {
+            this->stats_->active.add(1);
+        }
+        asio::co_spawn(this->executor_, [self = shared_from_this()]() { return self->doRead(); }, asio::detached);
+        asio::co_spawn(this->executor_, [self = shared_from_this()]() { return self->doWrite(); }, asio::detached);
+    }
+
+    const std::string &Session::OutgoingMessage::get() const
+    {
+        return this->shared != nullptr ? *this->shared : this->owned;
     }
 
     void Session::send(const std::string &message)
     {
-        bool writeInProgress = !this->messages_.empty();
-        messages_.push(message);
-        if (writeInProgress == false) {
-            this->doWrite();
-        }
+        UNO_TRACE_SPAN("enqueue");
+        messages_.push({message, nullptr, nullptr});
+        this->writeSignal_.cancel();
+    }
+
+    void Session::send(std::shared_ptr<const std::string> message, std::shared_ptr<void> completion)
+    {
+        UNO_TRACE_SPAN("enqueue");
+        messages_.push({{}, std::move(message), std::move(completion)});
+        this->writeSignal_.cancel();
+    }
+
+    void Session::close()
+    {
+        asio::error_code ec;
+        this->socket_.close(ec);
+        this->writeSignal_.cancel();
+        this->throttleTimer_.cancel();
     }
 
-    void Session::doRead()
+    std::chrono::steady_clock::time_point Session::dispatchTime()
     {
-        auto messageLength = std::make_shared<size_t>(0);
-        asio::async_read(socket_,
-                         asio::buffer(messageLength.get(), sizeof(size_t)),
-                         [this, self = shared_from_this(), messageLength](const asio::error_code &ec, size_t length) {
-                             if (!ec) {
-                                 if (*messageLength <= 10 * 1024 * 1024) {
-                                     this->doReadBody(*messageLength);
-                                 }
-                                 else {
-                                     doRead();
-                                 }
-                             }
-                         });
+        return currentDispatchTime;
     }
 
-    void Session::doReadBody(size_t length)
+    void Session::countDisconnected()
     {
-        auto buffer = std::make_shared<std::vector<char>>(length);
-        asio::async_read(
-            socket_, asio::buffer(*buffer), [this, self = shared_from_this(), buffer](const asio::error_code &ec, size_t length) {
-                if (!ec) {
-                    std::string message = {buffer->begin(), buffer->end()};
-                    this->callback_(message);
-                    doRead();
+        if (this->stats_ != nullptr) {
+            this->stats_->disconnected.add();
+        }
+    }
+
+    asio::awaitable<void, SessionExecutor> Session::doRead()
+    {
+        asio::error_code ec;
+        while (true) {
+            co_await asio::async_read(socket_, asio::buffer(&this->readLength_, sizeof(size_t)), sessionToken(this->readMemory_, ec));
+            if (ec) {
+                break;
+            }
+            // 限速在读取和解析消息体之前进行：超速时暂停读取，由 TCP 流量控制让对端慢下来；
+            // 消息过长或近期累计等待过久说明对端不是正常的客户端，直接断开
+            if (this->readLength_ > MaxMessageLength || static_cast<double>(this->readLength_) > this->byteBucket_.getCapacity()) {
+                this->countDisconnected();
+                break;
+            }
+            auto now   = TokenBucket::Clock::now();
+            auto delay = std::max(this->messageBucket_.take(1, now), this->byteBucket_.take(static_cast<double>(this->readLength_), now));
+            if (delay > TokenBucket::Clock::duration::zero()) {
+                if (this->throttleBudget_.take(std::chrono::duration<double>(delay).count(), now) > TokenBucket::Clock::duration::zero()) {
+                    this->countDisconnected();
+                    break;
+                }
+                if (this->stats_ != nullptr) {
+                    this->stats_->throttled.add();
+                }
+                this->throttleTimer_.expires_after(delay);
+                co_await this->throttleTimer_.async_wait(sessionToken(this->readMemory_, ec));
+                if (this->socket_.is_open() == false) {
+                    break;
                 }
-            });
+            }
+
+            this->readBody_.resize(this->readLength_);
+            {
+                UNO_TRACE_ASYNC_SPAN("read", this->readTraceId_);
+                co_await asio::async_read(socket_, asio::buffer(this->readBody_), sessionToken(this->readMemory_, ec));
+            }
+            if (ec) {
+                break;
+            }
+            currentDispatchTime = std::chrono::steady_clock::now();
+            UNO_TRACE_SPAN("dispatch");
+            // 回调抛出的异常会被 detached 协程吞掉，在这里结束会话，保证连接被关闭且 onClose 被调用
+            try {
+                this->callback_(std::move(this->readBody_));
+            }
+            catch (const std::exception &) {
+                break;
+            }
+        }
+        this->close();
+        if (this->stats_ != nullptr) {
+            this->stats_->active.add(-1);
+        }
+        if (this->onClose_) {
+            this->onClose_();
+        }
     }
 
-    void Session::doWrite()
+    asio::awaitable<void, SessionExecutor> Session::doWrite()
     {
-        auto message = this->messages_.front();
-        this->messages_.pop();
+        asio::error_code ec;
+        while (this->socket_.is_open()) {
+            if (this->messages_.empty()) {
+                this->writeSignal_.expires_at(asio::steady_timer::time_point::max());
+                co_await this->writeSignal_.async_wait(sessionToken(this->writeMemory_, ec));
+                continue;
+            }
 
-        auto length = std::make_shared<size_t>(message.size());
-        auto msg    = std::make_shared<std::string>(message);
+            // 队列中的消息在写完之前不会出队，std::queue 的 push 不会使 front 的引用失效
+            const auto &message = this->messages_.front().get();
+            this->writeLength_  = message.size();
 
-        std::array<asio::const_buffer, 2> buffers = {asio::buffer(length.get(), sizeof(size_t)), asio::buffer(*msg)};
-        asio::async_write(socket_, buffers, [this, self = shared_from_this(), length, msg](const asio::error_code &ec, size_t) {
-            if (!ec && this->messages_.empty() == false) {
-                this->doWrite();
+            std::array<asio::const_buffer, 2> buffers = {asio::buffer(&this->writeLength_, sizeof(size_t)), asio::buffer(message)};
+            {
+                UNO_TRACE_ASYNC_SPAN("write", this->writeTraceId_);
+                co_await asio::async_write(socket_, buffers, sessionToken(this->writeMemory_, ec));
             }
-        });
+            if (ec) {
+                break;
+            }
+            this->messages_.pop();
+        }
+        this->close();
     }
 }   // namespace UNO::NETWORK
@@ -6,27 +6,117 @@
  */
 #pragma once
 
+#include "../common/Metrics.h"
+#include "HandlerAllocator.h"
+#include "TokenBucket.h"
+
 #include <asio.hpp>
 #include <memory>
 #include <queue>
 
 namespace UNO::NETWORK {
 
+    /**
+     * 会话协程的执行器
+     *
+     * 使用 io_context 的具体执行器而不是类型擦除的 any_io_executor：后者分发完成处理器时总是走默认分配器，
+     * 只有具体执行器才会使用处理器的关联分配器
+     */
+    using SessionExecutor = asio::io_context::executor_type;
+
+    /**
+     * 同一服务端的所有会话共享的统计
+     */
+    struct SessionStats {
+        /**
+         * 仍在读取消息的连接数
+         */
+        COMMON::Gauge active;
+
+        /**
+         * 因超速而暂停读取的次数
+         */
+        COMMON::Counter throttled;
+
+        /**
+         * 因超出限制而被断开的连接数
+         */
+        COMMON::Counter disconnected;
+    };
+
     class Session : public std::enable_shared_from_this<Session> {
     private:
         asio::ip::tcp::socket socket_;
+        SessionExecutor executor_;
         std::function<void(std::string)> callback_;
+        std::function<void()> onClose_;
+
+        /**
+         * 待发送的消息：自有的副本，或与其他 Session 共享的缓冲区
+         *
+         * 自有的消息直接存放在队列中，不为共享指针的控制块额外分配内存；
+         * completion 在消息写完出队时释放
+         */
+        struct OutgoingMessage {
+            std::string owned;
+            std::shared_ptr<const std::string> shared;
+            std::shared_ptr<void> completion;
+
+            [[nodiscard]] const std::string &get() const;
+        };
+
+        std::queue<OutgoingMessage> messages_;
+
+        /**
+         * 写协程在消息队列为空时等待该定时器，send 通过取消它来唤醒写协程
+         */
+        asio::steady_timer writeSignal_;
+
+        size_t readLength_;
+        std::string readBody_;
+        size_t writeLength_;
+
+        HandlerMemory readMemory_;
+        HandlerMemory writeMemory_;
+
+        /**
+         * 读写区间跨越 co_await，作为异步区间记录；读和写会相互重叠，各用一个 id
+         */
+        uint64_t readTraceId_;
+        uint64_t writeTraceId_;
+
+        /**
+         * 读取消息体之前按消息数与字节数限速，超速时读协程等待 throttleTimer_
+         */
+        TokenBucket messageBucket_;
+        TokenBucket byteBucket_;
 
-        std::queue<std::string> messages_;
+        /**
+         * 以秒为单位的限速等待预算，见 SessionLimits::maxThrottleDelay
+         */
+        TokenBucket throttleBudget_;
+        asio::steady_timer throttleTimer_;
+        std::shared_ptr<SessionStats> stats_;
 
     public:
-        explicit Session(asio::ip::tcp::socket socket);
+        /**
+         * 单条消息的最大长度，不受限速配置影响
+         */
+        static constexpr size_t MaxMessageLength = 10 * 1024 * 1024;
+
+        /**
+         * @param socket 已连接的 socket
+         * @param limits 读取消息时的限速配置，默认不限速
+         * @param stats 会话统计，可以为空
+         */
+        explicit Session(asio::ip::tcp::socket socket, const SessionLimits &limits = {}, std::shared_ptr<SessionStats> stats = nullptr);
 
         /**
          * 开始从网络读取消息
          * @param callback 回调函数
+         * @param onClose 连接断开、读协程结束时调用，可以为空
          */
-        void start(std::function<void(std::string)> callback);
+        void start(std::function<void(std::string)> callback, std::function<void()> onClose = {});
 
         /**
          * 发送消息
@@ -34,10 +124,31 @@ namespace UNO::NETWORK {
          */
         void send(const std::string &message);
 
+        /**
+         * 发送共享缓冲区中的消息，不复制消息内容
+         * @param message 要发送的消息
+         * @param completion 消息写入 socket 后释放的对象，可以为空；多个消息共享同一个对象时，它在最后一个消息写完后析构
+         */
+        void send(std::shared_ptr<const std::string> message, std::shared_ptr<void> completion = nullptr);
+
+        /**
+         * 关闭连接，结束读写协程
+         */
+        void close();
+
+        /**
+         * @return 当前线程上正在交给回调的消息读取完成的时刻，只在回调中有意义
+         */
+        static std::chrono::steady_clock::time_point dispatchTime();
+
     private:
-        void doRead();
-        void doReadBody(size_t length);
-        void doWrite();
+        /**
+         * 记录一次因超出限制而断开的连接
+         */
+        void countDisconnected();
+
+        asio::awaitable<void, SessionExecutor> doRead();
+        asio::awaitable<void, SessionExecutor> doWrite();
     };
 
-}   // namespace UNO::NETWORK
\ No newline at end of file
+}   // namespace UNO::NETWORK
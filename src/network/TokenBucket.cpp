@@ -0,0 +1,48 @@
+/**
+ * @file TokenBucket.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#include "TokenBucket.h"
+
+#include <algorithm>
+
+namespace UNO::NETWORK {
+    TokenBucket::TokenBucket(double rate, double capacity, Clock::time_point now) :
+        rate_(rate), capacity_(capacity), tokens_(capacity), last_(now)
+    {
+    }
+
+    TokenBucket::Clock::duration TokenBucket::take(double count, Clock::time_point now)
+    {
+        if (this->rate_ == SessionLimits::Unlimited) {
+            return Clock::duration::zero();
+        }
+
+        auto elapsed  = std::chrono::duration<double>(now - this->last_).count();
+        this->tokens_ = std::min(this->capacity_, this->tokens_ + std::max(elapsed, 0.0) * this->rate_);
+        this->last_   = std::max(this->last_, now);
+
+        this->tokens_ -= count;
+        if (this->tokens_ >= 0) {
+            return Clock::duration::zero();
+        }
+        return std::chrono::ceil<Clock::duration>(std::chrono::duration<double>(-this->tokens_ / this->rate_));
+    }
+
+    double TokenBucket::getCapacity() const
+    {
+        return this->capacity_;
+    }
+
+    SessionLimits SessionLimits::forPlayers(double messagesPerSecond, double bytesPerSecond)
+    {
+        SessionLimits limits;
+        limits.messagesPerSecond = messagesPerSecond;
+        limits.messageBurst      = messagesPerSecond * 2;
+        limits.bytesPerSecond    = bytesPerSecond;
+        limits.byteBurst         = bytesPerSecond * 4;
+        return limits;
+    }
+}   // namespace UNO::NETWORK
@@ -0,0 +1,92 @@
+/**
+ * @file TokenBucket.h
+ *
+ * 会话的令牌桶限速
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace UNO::NETWORK {
+
+    /**
+     * 令牌桶
+     *
+     * 令牌按固定速率补充，最多积累 capacity 个；令牌不足时允许透支，透支的部分换算成调用方需要等待的时间
+     */
+    class TokenBucket {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        double rate_;
+        double capacity_;
+        double tokens_;
+        Clock::time_point last_;
+
+    public:
+        /**
+         * @param rate 每秒补充的令牌数，无穷大表示不限速
+         * @param capacity 最多积累的令牌数，桶初始是满的
+         * @param now 当前时间
+         */
+        TokenBucket(double rate, double capacity, Clock::time_point now = Clock::now());
+
+        /**
+         * 取出令牌，令牌不足时记为透支
+         * @param count 取出的令牌数
+         * @param now 当前时间
+         * @return 透支还清之前需要等待的时间，令牌足够时为 0
+         */
+        Clock::duration take(double count, Clock::time_point now = Clock::now());
+
+        /**
+         * @return 最多积累的令牌数，单次取出超过该值的请求永远无法在不透支的情况下满足
+         */
+        [[nodiscard]] double getCapacity() const;
+    };
+
+    /**
+     * 每个会话的限速配置
+     */
+    struct SessionLimits {
+        static constexpr double Unlimited = std::numeric_limits<double>::infinity();
+
+        /**
+         * 每秒消息数与允许的突发消息数
+         */
+        double messagesPerSecond = Unlimited;
+        double messageBurst      = Unlimited;
+
+        /**
+         * 每秒字节数与允许的突发字节数；消息长度超过 byteBurst 时直接断开
+         */
+        double bytesPerSecond = Unlimited;
+        double byteBurst      = Unlimited;
+
+        /**
+         * 因限速累计等待的预算：最多 maxThrottleDelay，每 throttleWindow 恢复 maxThrottleDelay，耗尽时断开连接
+         *
+         * 每次等待都会还清透支，只看单次等待无法识别持续超速的对端，它会被一直按 1/rate 的节奏放行；
+         * 偶尔的突发只消耗少量预算，持续超速的对端几乎一直在等待，预算很快耗尽
+         */
+        std::chrono::milliseconds maxThrottleDelay{2000};
+        std::chrono::milliseconds throttleWindow{10000};
+
+        /**
+         * 服务端接收玩家消息时使用的限制，突发允许 2 秒的消息数与 4 秒的字节数
+         *
+         * 玩家的消息都很小，正常游戏远达不到默认值
+         * @param messagesPerSecond 每秒消息数
+         * @param bytesPerSecond 每秒字节数
+         * @return 限速配置
+         */
+        static SessionLimits forPlayers(double messagesPerSecond = 50, double bytesPerSecond = 64 * 1024);
+    };
+
+}   // namespace UNO::NETWORK
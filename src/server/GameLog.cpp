@@ -0,0 +1,203 @@
+/**
+ * @file GameLog.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#include "GameLog.h"
+
+#include "../network/BinaryMessageSerializer.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace UNO::SERVER {
+    namespace {
+        /**
+         * 记录类型，编码为每条记录的第一个字节
+         */
+        enum class GameLogRecordType : uint8_t { JOIN = 1, START, PLAY, DRAW, END };
+
+        struct RecordEncoder {
+            COMMON::BinaryWriter &writer;
+
+            void operator()(const GameLogJoin &record) const
+            {
+                writer.writeByte(std::to_underlying(GameLogRecordType::JOIN));
+                writer.writeString(record.playerName);
+            }
+
+            void operator()(const GameLogStart &record) const
+            {
+                writer.writeByte(std::to_underlying(GameLogRecordType::START));
+                writer.writeVarint(record.seed);
+            }
+
+            void operator()(const GameLogPlay &record) const
+            {
+                writer.writeByte(std::to_underlying(GameLogRecordType::PLAY));
+                writer.writeVarint(record.player);
+                NETWORK::BinaryMessageSerializer::serializeCard(writer, record.card);
+            }
+
+            void operator()(const GameLogDraw &record) const
+            {
+                writer.writeByte(std::to_underlying(GameLogRecordType::DRAW));
+                writer.writeVarint(record.player);
+                writer.writeVarint(record.count);
+            }
+
+            void operator()(const GameLogEnd &record) const
+            {
+                writer.writeByte(std::to_underlying(GameLogRecordType::END));
+                writer.writeVarint(record.winner);
+            }
+        };
+
+        GameLogRecord decodeRecord(COMMON::BinaryReader &reader)
+        {
+            auto type = reader.readByte();
+            switch (static_cast<GameLogRecordType>(type)) {
+                case GameLogRecordType::JOIN: return GameLogJoin{reader.readString()};
+                case GameLogRecordType::START: return GameLogStart{static_cast<std::mt19937::result_type>(reader.readVarint())};
+                case GameLogRecordType::PLAY: {
+                    auto player = reader.readVarint();
+                    return GameLogPlay{player, NETWORK::BinaryMessageSerializer::deserializeCard(reader)};
+                }
+                case GameLogRecordType::DRAW: {
+                    auto player = reader.readVarint();
+                    return GameLogDraw{player, reader.readVarint()};
+                }
+                case GameLogRecordType::END: return GameLogEnd{reader.readVarint()};
+            }
+            throw std::invalid_argument("Invalid game log record type: " + std::to_string(type));
+        }
+
+        /**
+         * 按服务端处理对应消息时的顺序修改状态，并核对记录中的玩家与张数
+         */
+        struct RecordReplayer {
+            GAME::ServerGameState &gameState;
+
+            void operator()(const GameLogJoin &record) const
+            {
+                gameState.addPlayer(GAME::ServerPlayerState{record.playerName, 0, false});
+            }
+
+            void operator()(const GameLogStart &record) const
+            {
+                gameState.init(record.seed);
+            }
+
+            void operator()(const GameLogPlay &record) const
+            {
+                if (record.player != gameState.getCurrentPlayerId()) {
+                    throw std::invalid_argument("Game log diverged: card played out of turn");
+                }
+                gameState.updateStateByCard(record.card);
+            }
+
+            void operator()(const GameLogDraw &record) const
+            {
+                if (record.player != gameState.getCurrentPlayerId()) {
+                    throw std::invalid_argument("Game log diverged: card drawn out of turn");
+                }
+                if (gameState.updateStateByDraw().size() != record.count) {
+                    throw std::invalid_argument("Game log diverged: wrong number of cards drawn");
+                }
+            }
+
+            void operator()(const GameLogEnd &record) const
+            {
+                if (record.winner >= gameState.getPlayers().size() || gameState.getPlayers()[record.winner].isEmpty() == false) {
+                    throw std::invalid_argument("Game log diverged: winner still holds cards");
+                }
+                gameState.endGame();
+            }
+        };
+    }   // namespace
+
+    void GameLog::encode(COMMON::BinaryWriter &writer, const GameLogRecord &record)
+    {
+        std::visit(RecordEncoder{writer}, record);
+    }
+
+    std::vector<GameLogSegment> GameLog::decode(std::string_view data)
+    {
+        if (data.starts_with(Magic) == false) {
+            throw std::invalid_argument("Not a game log");
+        }
+        std::vector<GameLogSegment> segments;
+        COMMON::BinaryReader reader(data);
+        while (reader.isEnd() == false) {
+            // 记录类型从 1 开始，不会与 Magic 的第一个字节混淆，记录之间出现的 Magic 总是新的段
+            auto rest = data.substr(data.size() - reader.remaining());
+            if (rest.starts_with(Magic)) {
+                segments.emplace_back();
+                reader = COMMON::BinaryReader(rest.substr(Magic.size()));
+                continue;
+            }
+            segments.back().push_back(decodeRecord(reader));
+        }
+        return segments;
+    }
+
+    void GameLog::replay(const GameLogSegment &records, GAME::ServerGameState &gameState)
+    {
+        for (const auto &record : records) {
+            std::visit(RecordReplayer{gameState}, record);
+        }
+    }
+
+    GameLogWriter::GameLogWriter(const std::filesystem::path &path) : file_(path, std::ios::binary | std::ios::app), isStopping_(false)
+    {
+        if (this->file_.is_open() == false) {
+            throw std::runtime_error("Cannot open game log " + path.string());
+        }
+        this->file_.write(GameLog::Magic.data(), static_cast<std::streamsize>(GameLog::Magic.size()));
+        this->thread_ = std::thread([this]() { this->doWrite(); });
+    }
+
+    GameLogWriter::~GameLogWriter()
+    {
+        {
+            std::lock_guard lock(this->mutex_);
+            this->isStopping_ = true;
+        }
+        this->condition_.notify_one();
+        this->thread_.join();
+    }
+
+    void GameLogWriter::append(const GameLogRecord &record)
+    {
+        COMMON::BinaryWriter writer;
+        GameLog::encode(writer, record);
+        {
+            std::lock_guard lock(this->mutex_);
+            this->pending_ += writer.getData();
+        }
+        this->condition_.notify_one();
+    }
+
+    void GameLogWriter::doWrite()
+    {
+        std::string batch;
+        while (true) {
+            bool isStopping = false;
+            {
+                std::unique_lock lock(this->mutex_);
+                this->condition_.wait(lock, [this]() { return this->isStopping_ || this->pending_.empty() == false; });
+                // 交换缓冲区，写文件时不持有锁，两个缓冲区的容量都被复用
+                std::swap(batch, this->pending_);
+                isStopping = this->isStopping_;
+            }
+
+            this->file_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            this->file_.flush();
+            batch.clear();
+            if (isStopping) {
+                return;
+            }
+        }
+    }
+}   // namespace UNO::SERVER
@@ -0,0 +1,135 @@
+/**
+ * @file GameLog.h
+ *
+ * 事件溯源的对局日志
+ *
+ * 日志只记录改变服务端状态的操作：玩家加入、每局的种子、出牌（含万能牌选择的颜色）、摸牌与结束；
+ * 从段的开头依次重放即可逐位重建每一局，不需要保存完整的状态
+ *
+ * 服务端每次启动都在文件末尾追加一个以 Magic 开头的段，段之间互不相关
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+#pragma once
+#include "../common/BinaryCodec.h"
+#include "../game/GameState.h"
+
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace UNO::SERVER {
+
+    /**
+     * 新玩家按加入顺序占用下一个座位
+     */
+    struct GameLogJoin {
+        std::string playerName;
+    };
+
+    struct GameLogStart {
+        std::mt19937::result_type seed;
+    };
+
+    struct GameLogPlay {
+        size_t player;
+        GAME::Card card;
+    };
+
+    /**
+     * 摸到的牌由种子决定，只记录张数用于校验
+     */
+    struct GameLogDraw {
+        size_t player;
+        size_t count;
+    };
+
+    struct GameLogEnd {
+        size_t winner;
+    };
+
+    using GameLogRecord = std::variant<GameLogJoin, GameLogStart, GameLogPlay, GameLogDraw, GameLogEnd>;
+
+    /**
+     * 服务端一次运行写下的所有记录
+     */
+    using GameLogSegment = std::vector<GameLogRecord>;
+
+    class GameLog {
+    public:
+        /**
+         * 每个段的开头，最后一个字节为格式版本
+         */
+        static constexpr std::string_view Magic = "UNOLOG\x01";
+
+        /**
+         * @param writer 写入的位置
+         * @param record 要编码的记录
+         */
+        static void encode(COMMON::BinaryWriter &writer, const GameLogRecord &record);
+
+        /**
+         * @param data 完整的日志文件内容，以 Magic 开头
+         * @return 按文件中的顺序排列的所有段；数据不完整或格式错误时抛出 std::invalid_argument
+         */
+        static std::vector<GameLogSegment> decode(std::string_view data);
+
+        /**
+         * 在一个新的 ServerGameState 上依次重放记录
+         * @param records 从段的开头开始的记录
+         * @param gameState 重放的目标，必须是刚构造的状态
+         * @throw std::invalid_argument 记录与重放的状态不一致，例如出牌的不是当前玩家
+         */
+        static void replay(const GameLogSegment &records, GAME::ServerGameState &gameState);
+    };
+
+    /**
+     * 在后台线程上把日志写入文件，append 只编码记录并放入缓冲区，不等待磁盘
+     */
+    class GameLogWriter {
+    private:
+        std::ofstream file_;
+
+        /**
+         * 以下成员由 mutex_ 保护
+         */
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::string pending_;
+        bool isStopping_;
+
+        std::thread thread_;
+
+    private:
+        void doWrite();
+
+    public:
+        /**
+         * @param path 日志文件的路径，已经存在的文件不会被覆盖，新的段追加在末尾
+         */
+        explicit GameLogWriter(const std::filesystem::path &path);
+
+        /**
+         * 写完所有已追加的记录后关闭文件
+         */
+        ~GameLogWriter();
+
+        GameLogWriter(const GameLogWriter &)            = delete;
+        GameLogWriter &operator=(const GameLogWriter &) = delete;
+
+        /**
+         * 追加一条记录
+         * @param record 要追加的记录
+         */
+        void append(const GameLogRecord &record);
+    };
+
+}   // namespace UNO::SERVER
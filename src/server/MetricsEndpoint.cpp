@@ -0,0 +1,67 @@
+/**
+ * @file MetricsEndpoint.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#include "MetricsEndpoint.h"
+
+#include <array>
+#include <format>
+
+namespace UNO::SERVER {
+    MetricsEndpoint::MetricsEndpoint(uint16_t port, std::function<std::string()> render) :
+        acceptor_(io_context_, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port)), render_(std::move(render))
+    {
+        asio::co_spawn(this->io_context_, this->doAccept(), asio::detached);
+        this->thread_ = std::thread([this]() { this->io_context_.run(); });
+    }
+
+    MetricsEndpoint::~MetricsEndpoint()
+    {
+        this->io_context_.stop();
+        if (this->thread_.joinable()) {
+            this->thread_.join();
+        }
+    }
+
+    asio::awaitable<void> MetricsEndpoint::doAccept()
+    {
+        while (true) {
+            asio::error_code ec;
+            auto socket = co_await this->acceptor_.async_accept(asio::redirect_error(asio::use_awaitable, ec));
+            if (ec) {
+                co_return;
+            }
+            asio::co_spawn(this->io_context_, this->doServe(std::move(socket)), asio::detached);
+        }
+    }
+
+    asio::awaitable<void> MetricsEndpoint::doServe(asio::ip::tcp::socket socket)
+    {
+        asio::error_code ec;
+        std::string request;
+        co_await asio::async_read_until(
+            socket, asio::dynamic_buffer(request, MaxRequestLength), "\r\n\r\n", asio::redirect_error(asio::use_awaitable, ec));
+        if (ec) {
+            co_return;
+        }
+
+        std::string status = "404 Not Found";
+        std::string body;
+        if (request.starts_with("GET /metrics ") || request.starts_with("GET /metrics?")) {
+            status = "200 OK";
+            body   = this->render_();
+        }
+
+        auto header = std::format("HTTP/1.1 {}\r\n"
+                                  "Content-Type: text/plain; version=0.0.4\r\n"
+                                  "Content-Length: {}\r\n"
+                                  "Connection: close\r\n\r\n",
+                                  status,
+                                  body.size());
+        std::array<asio::const_buffer, 2> buffers = {asio::buffer(header), asio::buffer(body)};
+        co_await asio::async_write(socket, buffers, asio::redirect_error(asio::use_awaitable, ec));
+        socket.close(ec);
+    }
+}   // namespace UNO::SERVER
@@ -0,0 +1,51 @@
+/**
+ * @file MetricsEndpoint.h
+ *
+ * 在本机回环地址上以 Prometheus 文本格式提供运行指标
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#pragma once
+
+#include <asio.hpp>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace UNO::SERVER {
+
+    /**
+     * 只响应 GET /metrics 的最小 HTTP 服务
+     *
+     * 使用独立的 io_context 与线程，抓取指标不占用游戏的网络线程
+     */
+    class MetricsEndpoint {
+    private:
+        asio::io_context io_context_;
+        asio::ip::tcp::acceptor acceptor_;
+        std::function<std::string()> render_;
+        std::thread thread_;
+
+        asio::awaitable<void> doAccept();
+        asio::awaitable<void> doServe(asio::ip::tcp::socket socket);
+
+    public:
+        /**
+         * 请求头的最大长度，超过时直接关闭连接
+         */
+        static constexpr size_t MaxRequestLength = 8 * 1024;
+
+        /**
+         * 绑定 127.0.0.1 上的端口并开始服务
+         * @param port 端口
+         * @param render 生成指标文本，在服务线程上调用
+         */
+        MetricsEndpoint(uint16_t port, std::function<std::string()> render);
+        ~MetricsEndpoint();
+
+        MetricsEndpoint(const MetricsEndpoint &)            = delete;
+        MetricsEndpoint &operator=(const MetricsEndpoint &) = delete;
+    };
+
+}   // namespace UNO::SERVER
@@ -0,0 +1,41 @@
+/**
+ * @file ResumeTokens.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#include "ResumeTokens.h"
+
+#include <cstdint>
+#include <random>
+
+namespace UNO::SERVER {
+    std::string ResumeTokens::issue(size_t playerId)
+    {
+        // 令牌可以接管座位，不能使用可预测的伪随机数
+        static std::random_device device;
+        constexpr char Digits[] = "0123456789abcdef";
+
+        std::string token;
+        do {
+            token.clear();
+            for (size_t i = 0; i < TokenBytes; i++) {
+                auto byte = static_cast<uint8_t>(device());
+                token.push_back(Digits[byte >> 4]);
+                token.push_back(Digits[byte & 0x0F]);
+            }
+        } while (this->seats_.contains(token));
+
+        this->seats_.emplace(token, playerId);
+        return token;
+    }
+
+    std::optional<size_t> ResumeTokens::find(const std::string &token) const
+    {
+        auto it = this->seats_.find(token);
+        if (it == this->seats_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+}   // namespace UNO::SERVER
@@ -0,0 +1,41 @@
+/**
+ * @file ResumeTokens.h
+ *
+ * 断线重连使用的恢复令牌
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace UNO::SERVER {
+
+    class ResumeTokens {
+    private:
+        std::unordered_map<std::string, size_t> seats_;
+
+    public:
+        /**
+         * 令牌的随机字节数，以十六进制写出
+         */
+        static constexpr size_t TokenBytes = 16;
+
+        /**
+         * 为座位发放新的令牌
+         * @param playerId 座位对应的玩家游戏 ID
+         * @return 令牌
+         */
+        std::string issue(size_t playerId);
+
+        /**
+         * @param token 令牌
+         * @return 令牌对应的玩家游戏 ID，令牌无效时为 std::nullopt
+         */
+        [[nodiscard]] std::optional<size_t> find(const std::string &token) const;
+    };
+
+}   // namespace UNO::SERVER
@@ -0,0 +1,86 @@
+/**
+ * @file ServerMetrics.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#include "ServerMetrics.h"
+
+#include "../network/MessageSerializer.h"
+
+#include <format>
+
+namespace UNO::SERVER {
+    COMMON::Counter &ServerMetrics::received(NETWORK::MessagePayloadType payloadType)
+    {
+        return this->messagesReceived[std::to_underlying(payloadType)];
+    }
+
+    COMMON::Counter &ServerMetrics::sent(NETWORK::MessagePayloadType payloadType)
+    {
+        return this->messagesSent[std::to_underlying(payloadType)];
+    }
+
+    std::string ServerMetrics::toPrometheus(const NETWORK::SessionStats &sessions) const
+    {
+        COMMON::PrometheusWriter writer;
+
+        auto writeByType = [&writer](std::string_view name, const std::array<COMMON::Counter, PayloadTypeCount> &counters) {
+            for (size_t i = 0; i < PayloadTypeCount; i++) {
+                auto type = NETWORK::MessageSerializer::serializeMessagePayloadType(static_cast<NETWORK::MessagePayloadType>(i));
+                writer.write(name, std::format("type=\"{}\"", type), counters[i]);
+            }
+        };
+        writer.family("uno_messages_received_total", "Messages received from players by payload type", "counter");
+        writeByType("uno_messages_received_total", this->messagesReceived);
+        writer.family("uno_messages_sent_total", "Messages sent to players by payload type", "counter");
+        writeByType("uno_messages_sent_total", this->messagesSent);
+        writer.family("uno_messages_rejected_total", "Player messages answered with INVALID", "counter");
+        writer.write("uno_messages_rejected_total", "", this->messagesRejected);
+        writer.family("uno_handler_failures_total", "Player messages whose handler threw; their connection was closed", "counter");
+        writer.write("uno_handler_failures_total", "", this->handlerFailures);
+
+        writer.family("uno_received_bytes_total", "Bytes of player messages received", "counter");
+        writer.write("uno_received_bytes_total", "", this->bytesReceived);
+        writer.family("uno_sent_bytes_total", "Bytes of messages sent to players", "counter");
+        writer.write("uno_sent_bytes_total", "", this->bytesSent);
+
+        writer.family("uno_active_sessions", "Open player connections", "gauge");
+        writer.write("uno_active_sessions", "", sessions.active);
+        writer.family("uno_active_rooms", "Games in progress", "gauge");
+        writer.write("uno_active_rooms", "", this->activeRooms);
+        writer.family("uno_throttled_total", "Times a connection was paused for exceeding its rate limit", "counter");
+        writer.write("uno_throttled_total", "", sessions.throttled);
+        writer.family("uno_rate_limit_disconnects_total", "Connections closed for exceeding their limits", "counter");
+        writer.write("uno_rate_limit_disconnects_total", "", sessions.disconnected);
+
+        writer.family("uno_deserialize_seconds", "Time spent decoding player messages", "histogram");
+        writer.write("uno_deserialize_seconds", "stage=\"header\"", this->deserializeHeader);
+        writer.write("uno_deserialize_seconds", "stage=\"payload\"", this->deserializePayload);
+        writer.family("uno_serialize_seconds", "Time spent serializing messages that missed the frame cache", "histogram");
+        writer.write("uno_serialize_seconds", "", this->serialize);
+
+        writer.family("uno_handler_seconds", "Time spent in game event handlers", "histogram");
+        writer.write("uno_handler_seconds", "handler=\"play_card\"", this->handlePlayCard);
+        writer.write("uno_handler_seconds", "handler=\"draw_card\"", this->handleDrawCard);
+        writer.write("uno_handler_seconds", "handler=\"start_game\"", this->handleStartGame);
+
+        writer.family("uno_turn_latency_seconds", "Time from reading a player message until all messages it caused were written", "summary");
+        for (size_t i = 0; i < PayloadTypeCount; i++) {
+            auto type = NETWORK::MessageSerializer::serializeMessagePayloadType(static_cast<NETWORK::MessagePayloadType>(i));
+            writer.write("uno_turn_latency_seconds", std::format("type=\"{}\"", type), this->turnLatency[i]);
+        }
+
+        return writer.str();
+    }
+
+    TurnTrace::TurnTrace(COMMON::LatencyHistogram &histogram, std::chrono::steady_clock::time_point start) :
+        histogram_(histogram), start_(start)
+    {
+    }
+
+    TurnTrace::~TurnTrace()
+    {
+        this->histogram_.record(std::chrono::steady_clock::now() - this->start_);
+    }
+}   // namespace UNO::SERVER
@@ -0,0 +1,100 @@
+/**
+ * @file ServerMetrics.h
+ *
+ * 服务端的运行指标
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+#pragma once
+#include "../common/Metrics.h"
+#include "../network/Message.h"
+#include "../network/Session.h"
+
+#include <array>
+#include <string>
+#include <utility>
+
+namespace UNO::SERVER {
+
+    struct ServerMetrics {
+        static constexpr size_t PayloadTypeCount = std::to_underlying(NETWORK::MessagePayloadType::SESSION) + 1;
+
+        /**
+         * 按负载类型统计的收发消息数，发给多个玩家的消息按接收者计数
+         */
+        std::array<COMMON::Counter, PayloadTypeCount> messagesReceived;
+        std::array<COMMON::Counter, PayloadTypeCount> messagesSent;
+        COMMON::Counter bytesReceived;
+        COMMON::Counter bytesSent;
+        COMMON::Counter messagesRejected;
+
+        /**
+         * 处理时抛出异常的玩家消息数，发出这些消息的连接已被关闭
+         */
+        COMMON::Counter handlerFailures;
+
+        /**
+         * 正在进行的对局数
+         */
+        COMMON::Gauge activeRooms;
+
+        /**
+         * 解码分为消息头与负载两步；序列化只统计没有命中帧缓存的消息
+         */
+        COMMON::Histogram deserializeHeader;
+        COMMON::Histogram deserializePayload;
+        COMMON::Histogram serialize;
+
+        COMMON::Histogram handlePlayCard;
+        COMMON::Histogram handleDrawCard;
+        COMMON::Histogram handleStartGame;
+
+        /**
+         * 按负载类型统计的端到端延迟：从消息读取完成到它引起的所有消息都写入各个接收者的 socket
+         */
+        std::array<COMMON::LatencyHistogram, PayloadTypeCount> turnLatency;
+
+        /**
+         * @param payloadType 负载类型
+         * @return 该类型的接收计数器
+         */
+        COMMON::Counter &received(NETWORK::MessagePayloadType payloadType);
+
+        /**
+         * @param payloadType 负载类型
+         * @return 该类型的发送计数器
+         */
+        COMMON::Counter &sent(NETWORK::MessagePayloadType payloadType);
+
+        /**
+         * @param sessions 网络层的会话统计
+         * @return Prometheus 文本格式的所有指标
+         */
+        [[nodiscard]] std::string toPrometheus(const NETWORK::SessionStats &sessions) const;
+    };
+
+    /**
+     * 一条玩家消息的端到端计时
+     *
+     * 处理消息时发出的每个消息都持有同一个 TurnTrace，最后一个消息写完后析构并记录延迟；
+     * 没有引起任何消息的玩家消息记录的是处理耗时
+     */
+    class TurnTrace {
+    private:
+        COMMON::LatencyHistogram &histogram_;
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        /**
+         * @param histogram 记录延迟的直方图
+         * @param start 消息读取完成的时刻
+         */
+        TurnTrace(COMMON::LatencyHistogram &histogram, std::chrono::steady_clock::time_point start);
+        ~TurnTrace();
+
+        TurnTrace(const TurnTrace &)            = delete;
+        TurnTrace &operator=(const TurnTrace &) = delete;
+    };
+
+}   // namespace UNO::SERVER
@@ -0,0 +1,99 @@
+/**
+ * @file StateStream.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.17
+ */
+#include "StateStream.h"
+
+#include <algorithm>
+
+namespace UNO::SERVER {
+    const NETWORK::Message &StateEvent::viewFor(size_t playerId) const
+    {
+        if (this->privatePlayer == playerId) {
+            return *this->privateView;
+        }
+        return this->publicView;
+    }
+
+    StateStream::StateStream(size_t capacity) : capacity_(capacity), base_(NETWORK::NoSequence), version_(NETWORK::NoSequence) {}
+
+    uint64_t StateStream::nextSequence()
+    {
+        return ++this->version_;
+    }
+
+    void StateStream::trim()
+    {
+        uint64_t acknowledged = this->version_;
+        if (this->acknowledged_.empty() == false) {
+            acknowledged = std::ranges::min(this->acknowledged_);
+        }
+
+        while (this->events_.empty() == false
+               && (this->base_ < acknowledged || this->events_.size() > this->capacity_)) {
+            this->events_.pop_front();
+            this->base_++;
+        }
+    }
+
+    uint64_t StateStream::beginGame(size_t playerCount)
+    {
+        this->events_.clear();
+        this->base_ = this->nextSequence();
+        this->acknowledged_.assign(playerCount, this->base_);
+        return this->base_;
+    }
+
+    const StateEvent &StateStream::append(NETWORK::MessagePayloadType payloadType, NETWORK::MessagePayload payload)
+    {
+        auto sequence = this->nextSequence();
+        this->events_.push_back({{NETWORK::MessageStatus::OK, payloadType, std::move(payload), sequence}, std::nullopt, std::nullopt});
+        this->trim();
+        return this->events_.back();
+    }
+
+    const StateEvent &StateStream::append(NETWORK::MessagePayloadType payloadType,
+                                          NETWORK::MessagePayload publicPayload,
+                                          size_t privatePlayer,
+                                          NETWORK::MessagePayload privatePayload)
+    {
+        auto sequence = this->nextSequence();
+        this->events_.push_back({{NETWORK::MessageStatus::OK, payloadType, std::move(publicPayload), sequence},
+                                 privatePlayer,
+                                 NETWORK::Message{NETWORK::MessageStatus::OK, payloadType, std::move(privatePayload), sequence}});
+        this->trim();
+        return this->events_.back();
+    }
+
+    void StateStream::acknowledge(size_t playerId, uint64_t sequence)
+    {
+        // 这一局开始之后才加入的玩家没有需要确认的事件
+        if (playerId >= this->acknowledged_.size()) {
+            return;
+        }
+        auto &acknowledged = this->acknowledged_.at(playerId);
+        acknowledged       = std::max(acknowledged, std::min(sequence, this->version_));
+        this->trim();
+    }
+
+    std::optional<std::vector<NETWORK::Message>> StateStream::deltaFor(size_t playerId, uint64_t since) const
+    {
+        if (since < this->base_ || since > this->version_) {
+            return std::nullopt;
+        }
+
+        std::vector<NETWORK::Message> delta;
+        delta.reserve(this->version_ - since);
+        for (auto it = this->events_.begin() + static_cast<std::ptrdiff_t>(since - this->base_); it != this->events_.end(); ++it) {
+            delta.push_back(it->viewFor(playerId));
+        }
+        return delta;
+    }
+
+    uint64_t StateStream::getVersion() const
+    {
+        return this->version_;
+    }
+}   // namespace UNO::SERVER
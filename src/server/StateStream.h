@@ -0,0 +1,111 @@
+/**
+ * @file StateStream.h
+ *
+ * 带序号的状态事件流
+ *
+ * 每局游戏开始时版本号递增一次，之后每个事件（出牌、摸牌、结束）的序号依次加一；
+ * 服务端保留尚未被所有玩家确认的事件，落后的客户端可以从任意已确认的版本补齐增量，
+ * 超出保留范围时改为发送只含弃牌堆顶与手牌数量的快照
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.17
+ */
+#pragma once
+#include "../network/Message.h"
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace UNO::SERVER {
+
+    /**
+     * 一个状态事件；摸牌者看到的牌面与其他玩家看到的不同，因此事件最多有两个视图
+     */
+    struct StateEvent {
+        NETWORK::Message publicView;
+        std::optional<size_t> privatePlayer;
+        std::optional<NETWORK::Message> privateView;
+
+        /**
+         * @param playerId 玩家的游戏 ID
+         * @return 该玩家看到的视图
+         */
+        [[nodiscard]] const NETWORK::Message &viewFor(size_t playerId) const;
+    };
+
+    class StateStream {
+    private:
+        std::deque<StateEvent> events_;
+        size_t capacity_;
+
+        /**
+         * 日志中第一个事件之前的版本，从 base_ 开始的增量都可以补齐
+         */
+        uint64_t base_;
+        uint64_t version_;
+        std::vector<uint64_t> acknowledged_;
+
+        uint64_t nextSequence();
+
+        /**
+         * 丢弃所有玩家都已确认的事件以及超出容量的事件
+         */
+        void trim();
+
+    public:
+        /**
+         * 默认保留的事件数，足够覆盖断线数秒内的所有事件
+         */
+        static constexpr size_t DefaultCapacity = 256;
+
+        explicit StateStream(size_t capacity = DefaultCapacity);
+
+        /**
+         * 开始新的一局，清空日志
+         * @param playerCount 玩家数量
+         * @return 这一局的初始版本，随 INIT_GAME 一起发送
+         */
+        uint64_t beginGame(size_t playerCount);
+
+        /**
+         * 追加所有玩家看到相同内容的事件
+         * @return 追加的事件
+         */
+        const StateEvent &append(NETWORK::MessagePayloadType payloadType, NETWORK::MessagePayload payload);
+
+        /**
+         * 追加一名玩家看到不同内容的事件
+         * @param payloadType 负载类型
+         * @param publicPayload 其他玩家看到的负载
+         * @param privatePlayer 看到私有负载的玩家的游戏 ID
+         * @param privatePayload 私有负载
+         * @return 追加的事件
+         */
+        const StateEvent &append(NETWORK::MessagePayloadType payloadType,
+                                 NETWORK::MessagePayload publicPayload,
+                                 size_t privatePlayer,
+                                 NETWORK::MessagePayload privatePayload);
+
+        /**
+         * 记录玩家已经应用了序号不超过 sequence 的事件
+         * @param playerId 玩家的游戏 ID
+         * @param sequence 确认的序号
+         */
+        void acknowledge(size_t playerId, uint64_t sequence);
+
+        /**
+         * @param playerId 玩家的游戏 ID
+         * @param since 玩家已经应用的最后一个序号
+         * @return 序号大于 since 的事件在该玩家视角下的消息；日志已不包含这些事件时为 std::nullopt
+         */
+        [[nodiscard]] std::optional<std::vector<NETWORK::Message>> deltaFor(size_t playerId, uint64_t since) const;
+
+        /**
+         * @return 当前版本，即最后一个事件的序号
+         */
+        [[nodiscard]] uint64_t getVersion() const;
+    };
+
+}   // namespace UNO::SERVER
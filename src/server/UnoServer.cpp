@@ -6,96 +6,403 @@
  */
 #include "UnoServer.h"
 
-#include "../network/MessageSerializer.h"
+#include "../common/Trace.h"
+#include "../common/Utf8.h"
+#include "../common/Utils.h"
+
+#include <algorithm>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <utility>
 
 namespace UNO::SERVER {
-    UnoServer::UnoServer(uint16_t port) :
-        networkServer_(port, [this](size_t playerId, const std::string &message) { this->handlePlayerMessage(playerId, message); }),
-        playerCount(0)
+    UnoServer::UnoServer(uint16_t port,
+                         bool sendFullDiscardPile,
+                         const NETWORK::SessionLimits &limits,
+                         uint16_t metricsPort,
+                         const std::filesystem::path &gameLogPath) :
+        networkServer_(
+            port, [this](size_t playerId, const std::string &message) { this->handlePlayerMessage(playerId, message); }, limits),
+        playerCount(0),
+        sendFullDiscardPile_(sendFullDiscardPile)
     {
+        if (metricsPort != 0) {
+            this->metricsEndpoint_ = std::make_unique<MetricsEndpoint>(
+                metricsPort, [this]() { return this->metrics_.toPrometheus(this->networkServer_.getSessionStats()); });
+        }
+        if (gameLogPath.empty() == false) {
+            this->gameLog_ = std::make_unique<GameLogWriter>(gameLogPath);
+        }
     }
 
+    namespace {
+        /**
+         * 解码消息头；解码器对格式错误的数据抛出异常，这里是服务端唯一捕获它们的地方
+         */
+        std::expected<NETWORK::MessageView, Rejection> parseHeader(const std::string &message, COMMON::Histogram &timing)
+        {
+            UNO_TRACE_SPAN("parse.header");
+            COMMON::ScopedTimer timer(timing);
+            try {
+                return NETWORK::MessageView(message);
+            }
+            catch (const std::exception &) {
+                return std::unexpected(Rejection::MALFORMED_MESSAGE);
+            }
+        }
+
+        std::expected<NETWORK::MessagePayload, Rejection> decodePayload(const NETWORK::MessageView &message, COMMON::Histogram &timing)
+        {
+            UNO_TRACE_SPAN("parse.payload");
+            COMMON::ScopedTimer timer(timing);
+            try {
+                return message.decode().getMessagePayload();
+            }
+            catch (const std::exception &) {
+                return std::unexpected(Rejection::MALFORMED_MESSAGE);
+            }
+        }
+    }   // namespace
+
     void UnoServer::handlePlayerMessage(size_t playerId, const std::string &message)
     {
-        auto playerMessage = NETWORK::MessageSerializer::deserialize(message);
+        this->metrics_.bytesReceived.add(message.size());
 
-        if (playerMessage.getMessageStatus() == NETWORK::MessageStatus::OK) {
-            if (playerMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::JOIN_GAME) {
-                auto playerName = std::get<NETWORK::JoinGamePayload>(playerMessage.getMessagePayload()).playerName;
-
-                this->networkIdToGameId[playerId]          = this->playerCount;
-                this->gameIdToNetworkId[this->playerCount] = playerId;
-                this->playerCount++;
-                this->serverGameState_.addPlayer(GAME::ServerPlayerState{playerName, 0, false});
+        // 非法输入只拒绝这一条消息，不能让异常逃出 io_context 使整个服务端退出
+        try {
+            if (this->processPlayerMessage(playerId, message).has_value() == false) {
+                const auto &frame = NETWORK::MessageSerializer::invalidFrame(NETWORK::MessageSerializer::detectEncoding(message));
+                this->networkServer_.send(playerId, frame, this->currentTrace_);
+                this->metrics_.messagesRejected.add();
+                this->metrics_.sent(NETWORK::MessagePayloadType::EMPTY).add();
+                this->metrics_.bytesSent.add(frame->size());
             }
-            if (playerMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::START_GAME) {
-                this->isReadyToStart[networkIdToGameId[playerId]] = true;
+        }
+        // 通过校验之后仍然抛出异常是服务端的缺陷：记录下来并关闭这个连接，玩家可以凭恢复令牌重连
+        catch (const std::exception &e) {
+            std::cerr << std::format("Closing connection {} after a failed message: {}", playerId, e.what()) << std::endl;
+            this->metrics_.handlerFailures.add();
+            this->networkServer_.removePlayer(playerId);
+        }
+        // 已经交给网络层的消息仍持有计时，最后一个写完时记录延迟
+        this->currentTrace_.reset();
+    }
 
-                for (size_t i = 0; i <= this->playerCount; i++) {
-                    if (i == this->playerCount) {
-                        this->handleStartGame();
-                        break;
-                    }
-                    if (isReadyToStart[i] == false) {
-                        break;
-                    }
-                }
+    std::expected<void, Rejection> UnoServer::processPlayerMessage(size_t playerId, const std::string &message)
+    {
+        // 先只解码消息头，负载在消息通过校验之后才解码
+        auto playerMessage = parseHeader(message, this->metrics_.deserializeHeader);
+        if (playerMessage.has_value() == false) {
+            return std::unexpected(playerMessage.error());
+        }
+        auto &latency = this->metrics_.turnLatency[std::to_underlying(playerMessage->getMessagePayloadType())];
+        this->metrics_.received(playerMessage->getMessagePayloadType()).add();
+        this->currentTrace_ = std::make_shared<TurnTrace>(latency, NETWORK::Session::dispatchTime());
+        if (playerMessage->getMessageStatus() != NETWORK::MessageStatus::OK) {
+            return {};
+        }
+
+        auto payloadType = playerMessage->getMessagePayloadType();
+        switch (payloadType) {
+            case NETWORK::MessagePayloadType::EMPTY:
+            case NETWORK::MessagePayloadType::INIT_GAME:
+            case NETWORK::MessagePayloadType::END_GAME:
+            case NETWORK::MessagePayloadType::SYNC:
+            case NETWORK::MessagePayloadType::SESSION: return std::unexpected(Rejection::FORBIDDEN_PAYLOAD_TYPE);
+            case NETWORK::MessagePayloadType::JOIN_GAME:
+            case NETWORK::MessagePayloadType::START_GAME:
+            case NETWORK::MessagePayloadType::DRAW_CARD:
+            case NETWORK::MessagePayloadType::PLAY_CARD:
+            case NETWORK::MessagePayloadType::ACK:
+            case NETWORK::MessagePayloadType::SYNC_REQUEST: break;
+        }
+
+        if (payloadType == NETWORK::MessagePayloadType::JOIN_GAME) {
+            auto payload = decodePayload(*playerMessage, this->metrics_.deserializePayload);
+            if (payload.has_value() == false) {
+                return std::unexpected(payload.error());
             }
-            if (playerMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::INIT_GAME
-                || playerMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::END_GAME) {
-                throw std::invalid_argument("Invalid message payload type from client");
+            return this->handleJoinGame(playerId, playerMessage->getEncoding(), std::get<NETWORK::JoinGamePayload>(std::move(*payload)));
+        }
+
+        // 座位、阶段与回合都只依赖消息头
+        auto gameId = this->seatOf(playerId);
+        if (gameId.has_value() == false) {
+            return std::unexpected(gameId.error());
+        }
+        auto inGame = this->serverGameState_.getServerGameStage() == GAME::ServerGameStage::IN_GAME;
+        if ((payloadType == NETWORK::MessagePayloadType::START_GAME && inGame)
+            || ((payloadType == NETWORK::MessagePayloadType::DRAW_CARD || payloadType == NETWORK::MessagePayloadType::PLAY_CARD)
+                && inGame == false)) {
+            return std::unexpected(Rejection::WRONG_STAGE);
+        }
+        if (payloadType == NETWORK::MessagePayloadType::DRAW_CARD || payloadType == NETWORK::MessagePayloadType::PLAY_CARD) {
+            if (auto turn = this->checkTurn(*gameId); turn.has_value() == false) {
+                return turn;
             }
-            if (this->serverGameState_.getServerGameStage() == GAME::ServerGameStage::IN_GAME
-                && this->networkIdToGameId.at(playerId) != this->serverGameState_.getCurrentPlayerId()) {
-                throw std::invalid_argument("Invalid player message: not this player's turn");
+        }
+
+        auto payload = decodePayload(*playerMessage, this->metrics_.deserializePayload);
+        if (payload.has_value() == false) {
+            return std::unexpected(payload.error());
+        }
+
+        switch (payloadType) {
+            case NETWORK::MessagePayloadType::START_GAME: this->handleReady(*gameId); return {};
+            // 确认与补齐请求不受回合限制
+            case NETWORK::MessagePayloadType::ACK:
+                this->stateStream_.acknowledge(*gameId, std::get<NETWORK::AckPayload>(*payload).sequence);
+                return {};
+            case NETWORK::MessagePayloadType::SYNC_REQUEST:
+                this->handleSyncRequest(*gameId, std::get<NETWORK::SyncRequestPayload>(*payload).fromSequence);
+                return {};
+            case NETWORK::MessagePayloadType::DRAW_CARD: this->handleDrawCard(playerId); return {};
+            case NETWORK::MessagePayloadType::PLAY_CARD: {
+                auto card = std::get<NETWORK::PlayCardPayload>(*payload).card;
+                if (auto legal = this->checkCard(card); legal.has_value() == false) {
+                    return legal;
+                }
+                this->handlePlayCard(playerId, card);
+                return {};
             }
-            if (playerMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::DRAW_CARD) {
-                this->handleDrawCard(playerId);
+            case NETWORK::MessagePayloadType::EMPTY:
+            case NETWORK::MessagePayloadType::JOIN_GAME:
+            case NETWORK::MessagePayloadType::INIT_GAME:
+            case NETWORK::MessagePayloadType::END_GAME:
+            case NETWORK::MessagePayloadType::SYNC:
+            case NETWORK::MessagePayloadType::SESSION: break;
+        }
+        std::unreachable();
+    }
+
+    std::expected<size_t, Rejection> UnoServer::seatOf(size_t playerId) const
+    {
+        auto it = this->networkIdToGameId.find(playerId);
+        if (it == this->networkIdToGameId.end()) {
+            return std::unexpected(Rejection::NOT_JOINED);
+        }
+        return it->second;
+    }
+
+    std::expected<void, Rejection> UnoServer::checkTurn(size_t gameId) const
+    {
+        if (gameId != this->serverGameState_.getCurrentPlayerId()) {
+            return std::unexpected(Rejection::NOT_YOUR_TURN);
+        }
+        return {};
+    }
+
+    std::expected<void, Rejection> UnoServer::checkCard(const GAME::Card &card) const
+    {
+        const auto &player = this->serverGameState_.getPlayers()[this->serverGameState_.getCurrentPlayerId()];
+        if (player.hasCard(card) == false || this->serverGameState_.canPlay(card) == false) {
+            return std::unexpected(Rejection::ILLEGAL_CARD);
+        }
+        return {};
+    }
+
+    void UnoServer::sendToPlayer(size_t playerId, const NETWORK::Message &message)
+    {
+        this->sendToAudience(message, {playerId});
+    }
+
+    void UnoServer::sendToAudience(const NETWORK::Message &message, const std::vector<size_t> &recipients)
+    {
+        this->metrics_.sent(message.getMessagePayloadType()).add(recipients.size());
+        std::map<NETWORK::MessageEncoding, std::shared_ptr<const std::string>> frames;
+        for (auto playerId : recipients) {
+            auto encoding = this->encodingOf(playerId);
+            auto &frame   = frames[encoding];
+            if (frame == nullptr) {
+                frame = NETWORK::MessageSerializer::findCachedFrame(message, encoding);
             }
-            if (playerMessage.getMessagePayloadType() == NETWORK::MessagePayloadType::PLAY_CARD) {
-                this->handlePlayCard(playerId, std::get<NETWORK::PlayCardPayload>(playerMessage.getMessagePayload()).card);
+            if (frame == nullptr) {
+                UNO_TRACE_SPAN("serialize");
+                COMMON::ScopedTimer timer(this->metrics_.serialize);
+                frame = std::make_shared<const std::string>(NETWORK::MessageSerializer::serialize(message, encoding));
             }
+            this->metrics_.bytesSent.add(frame->size());
+            this->networkServer_.send(this->gameIdToNetworkId.at(playerId), frame, this->currentTrace_);
         }
     }
 
-    void UnoServer::handleStartGame()
+    void UnoServer::broadcast(const NETWORK::Message &message)
+    {
+        std::vector<size_t> everyone(this->playerCount);
+        std::iota(everyone.begin(), everyone.end(), 0);
+        this->sendToAudience(message, everyone);
+    }
+
+    NETWORK::MessageEncoding UnoServer::encodingOf(size_t playerId) const
+    {
+        return this->networkIdToEncoding.at(this->gameIdToNetworkId.at(playerId));
+    }
+
+    std::vector<GAME::ClientPlayerState> UnoServer::clientPlayerStates() const
     {
-        serverGameState_.init();
         std::vector<GAME::ClientPlayerState> players;
         players.reserve(serverGameState_.getPlayers().size());
         for (const auto &player : serverGameState_.getPlayers()) {
             players.emplace_back(player.getName(), player.getRemainingCardCount(), player.getIsUno());
         }
+        return players;
+    }
+
+    void UnoServer::handleSyncRequest(size_t playerId, uint64_t fromSequence)
+    {
+        if (auto delta = this->stateStream_.deltaFor(playerId, fromSequence)) {
+            for (const auto &message : *delta) {
+                this->sendToPlayer(playerId, message);
+            }
+            return;
+        }
+        if (this->serverGameState_.getServerGameStage() != GAME::ServerGameStage::IN_GAME) {
+            return;
+        }
+
+        NETWORK::SyncPayload payload = {playerId,
+                                        this->clientPlayerStates(),
+                                        this->serverGameState_.getDiscardPile().getSummary(),
+                                        this->serverGameState_.getPlayers()[playerId].getCards(),
+                                        this->serverGameState_.getCurrentPlayerId(),
+                                        this->serverGameState_.getIsReversed(),
+                                        this->serverGameState_.getDrawCount()};
+        this->sendToPlayer(
+            playerId,
+            {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::SYNC, std::move(payload), this->stateStream_.getVersion()});
+    }
+
+    std::expected<void, Rejection> UnoServer::handleJoinGame(size_t playerId,
+                                                             NETWORK::MessageEncoding encoding,
+                                                             NETWORK::JoinGamePayload &&payload)
+    {
+        if (payload.resumeToken.empty() == false) {
+            return this->handleResume(playerId, encoding, payload);
+        }
+        if (this->networkIdToGameId.contains(playerId)) {
+            return std::unexpected(Rejection::ALREADY_JOINED);
+        }
+        // 名字会原样转发给每一名玩家，必须能用任何一种编码序列化
+        if (COMMON::isValidUtf8(payload.playerName) == false) {
+            return std::unexpected(Rejection::MALFORMED_MESSAGE);
+        }
+        if (this->serverGameState_.getServerGameStage() == GAME::ServerGameStage::IN_GAME) {
+            return std::unexpected(Rejection::WRONG_STAGE);
+        }
+
+        auto gameId                         = this->playerCount;
+        this->networkIdToEncoding[playerId] = encoding;
+        this->networkIdToGameId[playerId]   = gameId;
+        this->gameIdToNetworkId[gameId]     = playerId;
+        this->playerCount++;
+        this->appendGameLog(GameLogJoin{payload.playerName});
+        this->serverGameState_.addPlayer(GAME::ServerPlayerState{std::move(payload.playerName), 0, false});
+
+        NETWORK::SessionPayload session = {this->resumeTokens_.issue(gameId)};
+        this->sendToPlayer(gameId, {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::SESSION, std::move(session)});
+        return {};
+    }
+
+    std::expected<void, Rejection> UnoServer::handleResume(size_t playerId,
+                                                           NETWORK::MessageEncoding encoding,
+                                                           const NETWORK::JoinGamePayload &payload)
+    {
+        auto gameId = this->resumeTokens_.find(payload.resumeToken);
+        if (gameId.has_value() == false) {
+            return std::unexpected(Rejection::UNKNOWN_RESUME_TOKEN);
+        }
+        // 已经坐在一个座位上的连接只能恢复自己的座位，不能凭别人的令牌接管另一个座位
+        if (auto seat = this->networkIdToGameId.find(playerId); seat != this->networkIdToGameId.end() && seat->second != *gameId) {
+            return std::unexpected(Rejection::ALREADY_JOINED);
+        }
+
+        auto previous = this->gameIdToNetworkId.at(*gameId);
+        if (previous != playerId) {
+            this->networkIdToGameId.erase(previous);
+            this->networkIdToEncoding.erase(previous);
+            this->networkServer_.removePlayer(previous);
+        }
+
+        this->networkIdToEncoding[playerId] = encoding;
+        this->networkIdToGameId[playerId]   = *gameId;
+        this->gameIdToNetworkId[*gameId]    = playerId;
+
+        this->handleSyncRequest(*gameId, payload.lastSequence);
+        return {};
+    }
+
+    void UnoServer::handleReady(size_t gameId)
+    {
+        this->isReadyToStart[gameId] = true;
+
+        for (size_t i = 0; i <= this->playerCount; i++) {
+            if (i == this->playerCount) {
+                this->handleStartGame();
+                break;
+            }
+            if (isReadyToStart[i] == false) {
+                break;
+            }
+        }
+    }
+
+    void UnoServer::handleStartGame()
+    {
+        UNO_TRACE_SPAN("update.start_game");
+        COMMON::ScopedTimer timer(this->metrics_.handleStartGame);
+        // 一个服务端同时只有一局游戏
+        this->metrics_.activeRooms.set(1);
+        // 每局的种子取自全局的生成器并写入日志，重放时用同一个种子洗牌
+        auto seed = COMMON::Utils::getInstance()->getRandom().getGenerator()();
+        this->appendGameLog(GameLogStart{seed});
+        serverGameState_.init(seed);
+        auto players              = this->clientPlayerStates();
         size_t currentPlayerIndex = serverGameState_.getCurrentPlayerId();
+        auto version              = this->stateStream_.beginGame(playerCount);
+        auto discardSummary       = serverGameState_.getDiscardPile().getSummary();
         for (size_t i = 0; i < playerCount; i++) {
             NETWORK::InitGamePayload payload = {
-                i, players, serverGameState_.getDiscardPile(), serverGameState_.getPlayers()[i].getCards(), currentPlayerIndex};
-            this->networkServer_.send(
-                gameIdToNetworkId.at(i),
-                NETWORK::MessageSerializer::serialize({NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::INIT_GAME, payload}));
+                i, players, discardSummary, serverGameState_.getPlayers()[i].getCards(), currentPlayerIndex, std::nullopt};
+            if (this->sendFullDiscardPile_) {
+                payload.discardPile = serverGameState_.getDiscardPile();
+            }
+            this->sendToPlayer(i, {NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::INIT_GAME, std::move(payload), version});
         }
     }
 
     void UnoServer::handleDrawCard(size_t playerId)
     {
-        auto cards = this->serverGameState_.updateStateByDraw();
+        UNO_TRACE_SPAN("update.draw_card");
+        COMMON::ScopedTimer timer(this->metrics_.handleDrawCard);
+        auto cards  = this->serverGameState_.updateStateByDraw();
+        auto drawer = this->networkIdToGameId.at(playerId);
+        this->appendGameLog(GameLogDraw{drawer, cards.size()});
+
+        // 一次摸牌只有两个视图：摸牌者看到牌面，其他玩家只看到摸牌数
+        std::vector<size_t> others;
+        others.reserve(this->playerCount);
         for (size_t i = 0; i < playerCount; i++) {
-            auto networkId = gameIdToNetworkId.at(i);
-            NETWORK::DrawCardPayload payload;
-            if (networkId != playerId) {
-                payload = {cards.size(), {}};
-            }
-            else {
-                payload = {cards.size(), cards};
+            if (i != drawer) {
+                others.push_back(i);
             }
-            this->networkServer_.send(
-                networkId,
-                NETWORK::MessageSerializer::serialize({NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::DRAW_CARD, payload}));
         }
+
+        NETWORK::DrawCardPayload countOnly = {cards.size(), {}};
+        NETWORK::DrawCardPayload withCards = {cards.size(), std::move(cards)};
+        const auto &event =
+            this->stateStream_.append(NETWORK::MessagePayloadType::DRAW_CARD, std::move(countOnly), drawer, std::move(withCards));
+        this->sendToPlayer(drawer, *event.privateView);
+        this->sendToAudience(event.publicView, others);
     }
 
     void UnoServer::handlePlayCard(size_t playerId, GAME::Card card)
     {
+        UNO_TRACE_SPAN("update.play_card");
+        COMMON::ScopedTimer timer(this->metrics_.handlePlayCard);
+        this->appendGameLog(GameLogPlay{this->networkIdToGameId.at(playerId), card});
         this->serverGameState_.updateStateByCard(card);
 
         // 检查是否有玩家获胜（手牌为空）
@@ -107,11 +414,7 @@ namespace UNO::SERVER {
             }
         }
 
-        NETWORK::PlayCardPayload payload = {card};
-        auto message = NETWORK::MessageSerializer::serialize({NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::PLAY_CARD, payload});
-        for (size_t i = 0; i < playerCount; i++) {
-            this->networkServer_.send(gameIdToNetworkId.at(i), message);
-        }
+        this->broadcast(this->stateStream_.append(NETWORK::MessagePayloadType::PLAY_CARD, NETWORK::PlayCardPayload{card}).publicView);
 
         if (gameEnded) {
             this->handleEndGame();
@@ -120,17 +423,23 @@ namespace UNO::SERVER {
 
     void UnoServer::handleEndGame()
     {
+        const auto &players = this->serverGameState_.getPlayers();
+        auto winner         = std::ranges::find_if(players, [](const GAME::ServerPlayerState &player) { return player.isEmpty(); });
+        this->appendGameLog(GameLogEnd{static_cast<size_t>(winner - players.begin())});
         this->serverGameState_.endGame();
+        this->metrics_.activeRooms.set(0);
 
-        NETWORK::EndGamePayload payload{};
-        auto message = NETWORK::MessageSerializer::serialize({NETWORK::MessageStatus::OK, NETWORK::MessagePayloadType::END_GAME, payload});
+        this->broadcast(this->stateStream_.append(NETWORK::MessagePayloadType::END_GAME, NETWORK::EndGamePayload{}).publicView);
 
         for (size_t i = 0; i < playerCount; i++) {
-            this->networkServer_.send(gameIdToNetworkId.at(i), message);
+            this->isReadyToStart[i] = false;
         }
+    }
 
-        for (size_t i = 0; i < playerCount; i++) {
-            this->isReadyToStart[i] = false;
+    void UnoServer::appendGameLog(const GameLogRecord &record)
+    {
+        if (this->gameLog_ != nullptr) {
+            this->gameLog_->append(record);
         }
     }
 
@@ -139,4 +448,14 @@ namespace UNO::SERVER {
         this->networkServer_.run();
     }
 
+    void UnoServer::stop()
+    {
+        this->networkServer_.stop();
+    }
+
+    uint16_t UnoServer::getPort() const
+    {
+        return this->networkServer_.getPort();
+    }
+
 }   // namespace UNO::SERVER
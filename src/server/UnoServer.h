@@ -6,19 +6,71 @@
  */
 #pragma once
 #include "../game/GameState.h"
+#include "../network/MessageSerializer.h"
+#include "../network/MessageView.h"
 #include "../network/NetworkServer.h"
+#include "GameLog.h"
+#include "MetricsEndpoint.h"
+#include "ResumeTokens.h"
+#include "ServerMetrics.h"
+#include "StateStream.h"
+
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <vector>
 
 namespace UNO::SERVER {
 
+    /**
+     * 拒绝玩家消息的原因
+     *
+     * 校验通过 std::expected 逐级返回而不抛出异常，被拒绝的消息只会收到 INVALID 回复，不影响其他玩家
+     */
+    enum class Rejection {
+        MALFORMED_MESSAGE,
+        FORBIDDEN_PAYLOAD_TYPE,
+        NOT_JOINED,
+        ALREADY_JOINED,
+        WRONG_STAGE,
+        NOT_YOUR_TURN,
+        ILLEGAL_CARD,
+        UNKNOWN_RESUME_TOKEN
+    };
+
     class UnoServer {
     private:
         GAME::ServerGameState serverGameState_;
+
+        /**
+         * 必须先于 networkServer_ 声明：网络层析构时释放尚未写完的消息，它们持有的 TurnTrace 会向 metrics_ 记录延迟
+         */
+        ServerMetrics metrics_;
         NETWORK::NetworkServer networkServer_;
+        StateStream stateStream_;
+        ResumeTokens resumeTokens_;
+        std::unique_ptr<MetricsEndpoint> metricsEndpoint_;
+
+        /**
+         * 对局日志，未开启时为空
+         */
+        std::unique_ptr<GameLogWriter> gameLog_;
+
+        /**
+         * 正在处理的玩家消息的端到端计时，随处理期间发出的每个消息一起交给网络层
+         */
+        std::shared_ptr<TurnTrace> currentTrace_;
 
         size_t playerCount;
         std::map<size_t, size_t> gameIdToNetworkId;
         std::map<size_t, size_t> networkIdToGameId;
         std::map<size_t, bool> isReadyToStart;
+        std::map<size_t, NETWORK::MessageEncoding> networkIdToEncoding;
+
+        /**
+         * 调试选项：INIT_GAME 中附带完整的弃牌堆
+         */
+        bool sendFullDiscardPile_;
 
     private:
         /**
@@ -28,6 +80,96 @@ namespace UNO::SERVER {
          */
         void handlePlayerMessage(size_t playerId, const std::string &message);
 
+        /**
+         * 校验并处理玩家消息
+         * @param playerId 玩家 ID
+         * @param message 玩家消息
+         * @return 消息被拒绝时为拒绝的原因
+         */
+        std::expected<void, Rejection> processPlayerMessage(size_t playerId, const std::string &message);
+
+        /**
+         * @param playerId 玩家的网络 ID
+         * @return 玩家的游戏 ID，玩家尚未加入时为 Rejection::NOT_JOINED
+         */
+        [[nodiscard]] std::expected<size_t, Rejection> seatOf(size_t playerId) const;
+
+        /**
+         * 检查是否轮到玩家行动
+         * @param gameId 玩家的游戏 ID
+         */
+        [[nodiscard]] std::expected<void, Rejection> checkTurn(size_t gameId) const;
+
+        /**
+         * 检查当前玩家能否打出这张牌：牌在手中，且可以接在弃牌堆顶
+         * @param card 要打出的牌
+         */
+        [[nodiscard]] std::expected<void, Rejection> checkCard(const GAME::Card &card) const;
+
+        /**
+         * 按玩家加入时使用的编码向玩家发送消息
+         * @param playerId 玩家的游戏 ID
+         * @param message 要发送的消息
+         */
+        void sendToPlayer(size_t playerId, const NETWORK::Message &message);
+
+        /**
+         * 向一组看到同一视图的玩家发送消息
+         *
+         * 每种编码只序列化一次，形状固定的消息直接使用缓存的帧；组内所有玩家共享同一个缓冲区
+         * @param message 要发送的消息
+         * @param recipients 接收者的游戏 ID
+         */
+        void sendToAudience(const NETWORK::Message &message, const std::vector<size_t> &recipients);
+
+        /**
+         * 向所有玩家发送同一条消息
+         * @param message 要发送的消息
+         */
+        void broadcast(const NETWORK::Message &message);
+
+        /**
+         * @param playerId 玩家的游戏 ID
+         * @return 玩家加入时使用的编码
+         */
+        NETWORK::MessageEncoding encodingOf(size_t playerId) const;
+
+        /**
+         * @return 所有玩家对外可见的状态
+         */
+        std::vector<GAME::ClientPlayerState> clientPlayerStates() const;
+
+        /**
+         * 处理客户端的补齐请求：日志仍包含缺失的事件时发送增量，否则发送当前状态的快照
+         * @param playerId 玩家的游戏 ID
+         * @param fromSequence 玩家已经应用的最后一个序号
+         */
+        void handleSyncRequest(size_t playerId, uint64_t fromSequence);
+
+        /**
+         * 处理加入游戏：新玩家占用一个座位，带恢复令牌的玩家取回原来的座位
+         * @param playerId 玩家的网络 ID
+         * @param encoding 玩家使用的编码
+         * @param payload JOIN_GAME 负载
+         */
+        std::expected<void, Rejection>
+            handleJoinGame(size_t playerId, NETWORK::MessageEncoding encoding, NETWORK::JoinGamePayload &&payload);
+
+        /**
+         * 处理断线重连：把新的连接绑定到令牌对应的座位，关闭旧的连接，并补发错过的事件
+         * @param playerId 新连接的网络 ID
+         * @param encoding 新连接使用的编码
+         * @param payload 带恢复令牌的 JOIN_GAME 负载
+         */
+        std::expected<void, Rejection>
+            handleResume(size_t playerId, NETWORK::MessageEncoding encoding, const NETWORK::JoinGamePayload &payload);
+
+        /**
+         * 处理玩家准备开始游戏，所有玩家都准备好后开始游戏
+         * @param gameId 玩家的游戏 ID
+         */
+        void handleReady(size_t gameId);
+
         /**
          * 开始游戏
          */
@@ -51,13 +193,40 @@ namespace UNO::SERVER {
          */
         void handleEndGame();
 
+        /**
+         * 开启对局日志时追加一条记录
+         * @param record 要追加的记录
+         */
+        void appendGameLog(const GameLogRecord &record);
+
     public:
-        explicit UnoServer(uint16_t port = 10001);
+        /**
+         * @param port 监听的端口
+         * @param sendFullDiscardPile 调试选项：INIT_GAME 中附带完整的弃牌堆
+         * @param limits 每个玩家连接的限速配置
+         * @param metricsPort 在 127.0.0.1 的该端口上提供 Prometheus 格式的运行指标，为 0 时不提供
+         * @param gameLogPath 对局日志的路径，为空时不记录
+         */
+        explicit UnoServer(uint16_t port = 10001,
+                           bool sendFullDiscardPile = false,
+                           const NETWORK::SessionLimits &limits = NETWORK::SessionLimits::forPlayers(),
+                           uint16_t metricsPort = 0,
+                           const std::filesystem::path &gameLogPath = {});
 
         /**
-         * 启动服务器
+         * 启动服务器，直到 stop 被调用
          */
         void run();
+
+        /**
+         * 停止服务器，可以从其他线程调用
+         */
+        void stop();
+
+        /**
+         * @return 实际监听的端口
+         */
+        [[nodiscard]] uint16_t getPort() const;
     };
 
 }   // namespace UNO::SERVER
\ No newline at end of file
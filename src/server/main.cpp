@@ -6,12 +6,37 @@
  */
 #include <argparse/argparse.hpp>
 
+#include "../common/Trace.h"
 #include "UnoServer.h"
+
+#include <csignal>
+#include <fstream>
+#include <thread>
 int main(int argc, char *argv[])
 {
     argparse::ArgumentParser parser("Uno Server", "0.1.0");
 
     parser.add_argument("-p", "--port").help("server port").default_value(static_cast<uint16_t>(10001)).scan<'i', uint16_t>();
+    parser.add_argument("--full-discard-pile")
+        .help("debug: send the whole discard pile in INIT_GAME")
+        .default_value(false)
+        .implicit_value(true);
+    parser.add_argument("--messages-per-second")
+        .help("per-connection message rate limit, bursts of 2 seconds are allowed")
+        .default_value(50.0)
+        .scan<'g', double>();
+    parser.add_argument("--bytes-per-second")
+        .help("per-connection byte rate limit, bursts of 4 seconds are allowed and longer messages are rejected")
+        .default_value(64.0 * 1024)
+        .scan<'g', double>();
+    parser.add_argument("--metrics-port")
+        .help("serve Prometheus metrics on 127.0.0.1 at this port, 0 disables")
+        .default_value(static_cast<uint16_t>(0))
+        .scan<'i', uint16_t>();
+    parser.add_argument("--game-log")
+        .help("append every join, seed, play, draw and game end to this binary log for replay, one segment per run");
+    parser.add_argument("--trace")
+        .help("record read/parse/update/serialize/enqueue/write spans and write them to this file as Chrome trace-event JSON on exit");
 
     try {
         parser.parse_args(argc, argv);
@@ -23,8 +48,43 @@ int main(int argc, char *argv[])
     }
 
     try {
-        UNO::SERVER::UnoServer uno_server(parser.get<uint16_t>("--port"));
+        auto limits = UNO::NETWORK::SessionLimits::forPlayers(parser.get<double>("--messages-per-second"),
+                                                             parser.get<double>("--bytes-per-second"));
+        UNO::SERVER::UnoServer uno_server(parser.get<uint16_t>("--port"),
+                                          parser.get<bool>("--full-discard-pile"),
+                                          limits,
+                                          parser.get<uint16_t>("--metrics-port"),
+                                          parser.present("--game-log").value_or(""));
+
+        auto tracePath = parser.present("--trace");
+        if (tracePath.has_value() == false) {
+            uno_server.run();
+            return 0;
+        }
+
+        // 追踪文件在服务器停止后写出，因此收到 SIGINT 或 SIGTERM 时先让服务器正常退出
+        std::ofstream traceFile(*tracePath);
+        if (traceFile.is_open() == false) {
+            std::cerr << "Cannot open trace file " << *tracePath << std::endl;
+            return 1;
+        }
+        asio::io_context signals_context;
+        asio::signal_set signals(signals_context, SIGINT, SIGTERM);
+        signals.async_wait([&uno_server](const asio::error_code &ec, int) {
+            if (ec) {
+                return;
+            }
+            uno_server.stop();
+        });
+        std::thread signals_thread([&signals_context]() { signals_context.run(); });
+
+        UNO::COMMON::Tracer::enable();
         uno_server.run();
+        UNO::COMMON::Tracer::disable();
+
+        signals.cancel();
+        signals_thread.join();
+        UNO::COMMON::Tracer::writeChromeTrace(traceFile);
     }
     catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
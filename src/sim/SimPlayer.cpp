@@ -0,0 +1,66 @@
+/**
+ * @file SimPlayer.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "SimPlayer.h"
+
+#include <utility>
+
+namespace UNO::SIM {
+    SimPlayer::SimPlayer(asio::ip::tcp::socket socket, std::string name, NETWORK::MessageEncoding encoding, SimStats &stats) :
+        session_(std::make_shared<NETWORK::Session>(std::move(socket))),
+        core_(encoding,
+              [this](std::shared_ptr<const std::string> message) {
+                  this->session_->send(std::move(message));
+                  this->stats_.messagesSent++;
+              },
+              *this),
+        stats_(stats),
+        isWaiting_(false)
+    {
+        this->core_.setPlayerName(name);
+    }
+
+    void SimPlayer::start()
+    {
+        this->session_->start([this](std::string message) {
+            this->stats_.messagesReceived++;
+            this->core_.handleMessage(message);
+        });
+        this->core_.handleConnected();
+    }
+
+    bool SimPlayer::hasJoined() const
+    {
+        return this->core_.hasJoined();
+    }
+
+    void SimPlayer::ready()
+    {
+        this->core_.ready();
+    }
+
+    void SimPlayer::stop()
+    {
+        this->session_->close();
+        this->stats_.gamesEnded += this->core_.getGamesEnded();
+        this->stats_.messagesRejected += this->core_.getRejected();
+    }
+
+    void SimPlayer::onUpdate(CLIENT::ClientCore &core)
+    {
+        // 自己的出牌或摸牌被广播回来，这一回合结束
+        if (this->isWaiting_ && core.isWaiting() == false) {
+            this->stats_.turnLatency.record(std::chrono::steady_clock::now() - this->actionTime_);
+        }
+
+        this->bot_.onUpdate(core);
+
+        if (this->isWaiting_ == false && core.isWaiting()) {
+            this->actionTime_ = std::chrono::steady_clock::now();
+        }
+        this->isWaiting_ = core.isWaiting();
+    }
+}   // namespace UNO::SIM
@@ -0,0 +1,93 @@
+/**
+ * @file SimPlayer.h
+ *
+ * 模拟器中自动出牌的玩家
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#pragma once
+#include "../client/BotPolicy.h"
+#include "../client/ClientCore.h"
+#include "../common/LatencyHistogram.h"
+#include "../network/MessageSerializer.h"
+#include "../network/Session.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace UNO::SIM {
+
+    /**
+     * 所有模拟玩家共享的统计，只在客户端的网络线程上更新
+     */
+    struct SimStats {
+        uint64_t messagesSent     = 0;
+        uint64_t messagesReceived = 0;
+
+        /**
+         * 被服务端拒绝的消息数，正常情况下为 0
+         */
+        uint64_t messagesRejected = 0;
+
+        /**
+         * 每名玩家各记一次
+         */
+        uint64_t gamesEnded = 0;
+
+        /**
+         * 从发出出牌或摸牌到收到服务端对应广播的时间
+         */
+        COMMON::LatencyHistogram turnLatency;
+    };
+
+    /**
+     * 由 BotPolicy 出牌的模拟玩家，另外记录消息数与回合延迟
+     */
+    class SimPlayer : public CLIENT::ClientPolicy {
+    private:
+        std::shared_ptr<NETWORK::Session> session_;
+        CLIENT::ClientCore core_;
+        CLIENT::BotPolicy bot_;
+        SimStats &stats_;
+
+        /**
+         * 上一次 onUpdate 结束时是否在等待服务端的广播，以及开始等待的时刻
+         */
+        bool isWaiting_;
+        std::chrono::steady_clock::time_point actionTime_;
+
+    public:
+        /**
+         * @param socket 已连接到服务端的 socket
+         * @param name 玩家名字
+         * @param encoding 使用的编码
+         * @param stats 共享的统计
+         */
+        SimPlayer(asio::ip::tcp::socket socket, std::string name, NETWORK::MessageEncoding encoding, SimStats &stats);
+
+        /**
+         * 开始读取消息并加入游戏
+         */
+        void start();
+
+        /**
+         * @return 是否已经收到服务端分配的座位
+         */
+        [[nodiscard]] bool hasJoined() const;
+
+        /**
+         * 准备开始第一局；之后每局结束后 BotPolicy 会自动再次准备
+         */
+        void ready();
+
+        /**
+         * 断开连接，并把这名玩家的局数与被拒绝的消息数计入统计
+         */
+        void stop();
+
+        void onUpdate(CLIENT::ClientCore &core) override;
+    };
+
+}   // namespace UNO::SIM
@@ -0,0 +1,93 @@
+/**
+ * @file Simulator.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include "Simulator.h"
+
+#include "../common/Utils.h"
+#include "../server/UnoServer.h"
+#include "SimPlayer.h"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace UNO::SIM {
+    std::string SimReport::toJson() const
+    {
+        auto rate = [this](uint64_t count) { return this->seconds > 0 ? static_cast<double>(count) / this->seconds : 0.0; };
+        auto microseconds = [](std::chrono::nanoseconds latency) { return std::chrono::duration<double, std::micro>(latency).count(); };
+        return std::format(R"({{"seconds":{:.3f},"games":{},"games_per_second":{:.1f},"messages":{},"messages_per_second":{:.1f},)"
+                           R"("rejected":{},"turn_latency_us":{{"p50":{:.1f},"p99":{:.1f},"p999":{:.1f}}},"peak_rss_kib":{}}})",
+                           this->seconds,
+                           this->games,
+                           rate(this->games),
+                           this->messages,
+                           rate(this->messages),
+                           this->rejected,
+                           microseconds(this->turnLatencyP50),
+                           microseconds(this->turnLatencyP99),
+                           microseconds(this->turnLatencyP999),
+                           this->peakRssKib);
+    }
+
+    Simulator::Simulator(const SimConfig &config) : config_(config) {}
+
+    SimReport Simulator::run()
+    {
+        if (this->config_.players < 2) {
+            throw std::invalid_argument("A game needs at least two players");
+        }
+        COMMON::Utils::getInstance()->getRandom().seed(this->config_.seed);
+
+        // 玩家全部在本进程内，不限速
+        SERVER::UnoServer server(this->config_.port, false, NETWORK::SessionLimits{});
+        std::thread serverThread([&server]() { server.run(); });
+
+        // io_context 必须在玩家之后析构：挂起的协程持有 Session
+        asio::io_context io_context;
+        SimStats stats;
+        std::vector<std::unique_ptr<SimPlayer>> players;
+        asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), server.getPort());
+        for (size_t i = 0; i < this->config_.players; i++) {
+            asio::ip::tcp::socket socket(io_context);
+            socket.connect(endpoint);
+            players.push_back(std::make_unique<SimPlayer>(std::move(socket), "sim" + std::to_string(i), this->config_.encoding, stats));
+            players.back()->start();
+        }
+
+        // 所有玩家入座之后才准备，否则先准备好的玩家会在其他玩家加入之前开局
+        while (std::ranges::all_of(players, [](const auto &player) { return player->hasJoined(); }) == false) {
+            io_context.run_one();
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (auto &player : players) {
+            player->ready();
+        }
+        io_context.run_for(this->config_.duration);
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (auto &player : players) {
+            player->stop();
+        }
+        server.stop();
+        serverThread.join();
+
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return {seconds,
+                stats.gamesEnded / this->config_.players,
+                stats.messagesSent + stats.messagesReceived,
+                stats.messagesRejected,
+                stats.turnLatency.percentile(0.5),
+                stats.turnLatency.percentile(0.99),
+                stats.turnLatency.percentile(0.999),
+                usage.ru_maxrss};
+    }
+}   // namespace UNO::SIM
@@ -0,0 +1,85 @@
+/**
+ * @file Simulator.h
+ *
+ * 回环吞吐测试：在同一进程中启动服务端与若干自动出牌的玩家，尽可能快地连续对局
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#pragma once
+#include "../network/MessageSerializer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace UNO::SIM {
+
+    struct SimConfig {
+        /**
+         * 同一局中的玩家数
+         */
+        size_t players = 4;
+
+        /**
+         * 开始第一局之后运行的时长
+         */
+        std::chrono::milliseconds duration = std::chrono::seconds(10);
+
+        /**
+         * 洗牌使用的种子，种子相同则每一局的发牌与出牌顺序都相同
+         */
+        uint32_t seed = 1;
+
+        NETWORK::MessageEncoding encoding = NETWORK::MessageEncoding::BINARY;
+
+        /**
+         * 服务端监听的端口，为 0 时由系统分配
+         */
+        uint16_t port = 0;
+    };
+
+    struct SimReport {
+        double seconds;
+        uint64_t games;
+
+        /**
+         * 所有玩家收发的消息总数
+         */
+        uint64_t messages;
+
+        /**
+         * 被服务端拒绝的消息数，不为 0 说明玩家与服务端对规则的理解不一致
+         */
+        uint64_t rejected;
+
+        std::chrono::nanoseconds turnLatencyP50;
+        std::chrono::nanoseconds turnLatencyP99;
+        std::chrono::nanoseconds turnLatencyP999;
+
+        /**
+         * 整个进程（服务端与所有玩家）的峰值常驻内存，单位为 KiB
+         */
+        long peakRssKib;
+
+        /**
+         * @return 一行 JSON，便于在不同提交之间比较
+         */
+        [[nodiscard]] std::string toJson() const;
+    };
+
+    class Simulator {
+    private:
+        SimConfig config_;
+
+    public:
+        explicit Simulator(const SimConfig &config);
+
+        /**
+         * 运行模拟，阻塞直到达到配置的时长
+         * @return 测量结果
+         */
+        SimReport run();
+    };
+
+}   // namespace UNO::SIM
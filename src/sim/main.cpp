@@ -0,0 +1,71 @@
+/**
+ * @file main.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+#include <argparse/argparse.hpp>
+
+#include "../common/Trace.h"
+#include "Simulator.h"
+
+#include <fstream>
+
+int main(int argc, char *argv[])
+{
+    argparse::ArgumentParser parser("Uno Simulator", "0.1.0");
+
+    parser.add_argument("-n", "--players").help("players in the game").default_value(static_cast<size_t>(4)).scan<'u', size_t>();
+    parser.add_argument("-d", "--duration").help("seconds to run after the first game starts").default_value(10.0).scan<'g', double>();
+    parser.add_argument("--seed").help("shuffle seed, equal seeds replay equal games").default_value(1u).scan<'u', unsigned>();
+    parser.add_argument("--json").help("encode messages as JSON instead of binary").default_value(false).implicit_value(true);
+    parser.add_argument("-p", "--port")
+        .help("server port, 0 picks a free one")
+        .default_value(static_cast<uint16_t>(0))
+        .scan<'i', uint16_t>();
+    parser.add_argument("--trace").help("write server and player spans to this file as Chrome trace-event JSON");
+
+    try {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    try {
+        UNO::SIM::SimConfig config;
+        std::chrono::duration<double> duration(parser.get<double>("--duration"));
+        config.players  = parser.get<size_t>("--players");
+        config.duration = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+        config.seed     = parser.get<unsigned>("--seed");
+        config.encoding = parser.get<bool>("--json") ? UNO::NETWORK::MessageEncoding::JSON : UNO::NETWORK::MessageEncoding::BINARY;
+        config.port     = parser.get<uint16_t>("--port");
+
+        auto tracePath = parser.present("--trace");
+        std::ofstream traceFile;
+        if (tracePath.has_value()) {
+            traceFile.open(*tracePath);
+            if (traceFile.is_open() == false) {
+                std::cerr << "Cannot open trace file " << *tracePath << std::endl;
+                return 1;
+            }
+            UNO::COMMON::Tracer::enable();
+        }
+
+        auto report = UNO::SIM::Simulator(config).run();
+
+        if (tracePath.has_value()) {
+            UNO::COMMON::Tracer::disable();
+            UNO::COMMON::Tracer::writeChromeTrace(traceFile);
+        }
+        std::cout << report.toJson() << std::endl;
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file ClientCoreTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+
+#include "../../../src/client/BotPolicy.h"
+#include "../../../src/client/ClientCore.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::CLIENT;
+using namespace UNO::NETWORK;
+using namespace UNO::GAME;
+
+namespace {
+    class RecordingPolicy : public ClientPolicy {
+    public:
+        size_t updates = 0;
+
+        void onUpdate(ClientCore &core) override
+        {
+            this->updates++;
+        }
+    };
+
+    /**
+     * 记录 ClientCore 发出的所有消息
+     */
+    class ClientCoreTest : public testing::Test {
+    protected:
+        std::vector<Message> sent;
+
+        std::function<void(std::shared_ptr<const std::string>)> sender()
+        {
+            return [this](std::shared_ptr<const std::string> message) { this->sent.push_back(MessageSerializer::deserialize(*message)); };
+        }
+
+        static std::string serverMessage(MessagePayloadType payloadType, MessagePayload payload, uint64_t sequence)
+        {
+            return MessageSerializer::serialize({MessageStatus::OK, payloadType, std::move(payload), sequence});
+        }
+
+        /**
+         * @return 两名玩家的开局消息，当前玩家为自己，弃牌堆顶为红 1
+         */
+        static std::string initGame(uint64_t sequence, std::multiset<Card> handCard)
+        {
+            std::vector<ClientPlayerState> players = {ClientPlayerState("self", handCard.size(), false),
+                                                      ClientPlayerState("other", 7, false)};
+            return serverMessage(MessagePayloadType::INIT_GAME,
+                                 InitGamePayload{0, std::move(players), {Card(CardColor::RED, CardType::NUM1), 1}, handCard, 0},
+                                 sequence);
+        }
+    };
+}   // namespace
+
+TEST_F(ClientCoreTest, JoinsAndAcknowledgesSnapshot)
+{
+    RecordingPolicy policy;
+    ClientCore core(MessageEncoding::BINARY, this->sender(), policy);
+    core.setPlayerName("self");
+    core.handleConnected();
+    ASSERT_EQ(this->sent.size(), 1);
+    EXPECT_EQ(this->sent[0].getMessagePayloadType(), MessagePayloadType::JOIN_GAME);
+    EXPECT_EQ(core.getGameState()->getClientGameStage(), ClientGameStage::PRE_GAME);
+
+    core.handleMessage(serverMessage(MessagePayloadType::SESSION, SessionPayload{"token"}, NoSequence));
+    EXPECT_TRUE(core.hasJoined());
+
+    core.handleMessage(initGame(1, {Card(CardColor::RED, CardType::NUM2)}));
+    EXPECT_EQ(core.getGameState()->getClientGameStage(), ClientGameStage::ACTIVE);
+    ASSERT_EQ(this->sent.size(), 2);
+    EXPECT_EQ(this->sent[1].getMessagePayloadType(), MessagePayloadType::ACK);
+    EXPECT_EQ(policy.updates, 3);
+}
+
+TEST_F(ClientCoreTest, RequestsSyncOnGap)
+{
+    RecordingPolicy policy;
+    ClientCore core(MessageEncoding::BINARY, this->sender(), policy);
+    core.handleMessage(initGame(1, {Card(CardColor::RED, CardType::NUM2)}));
+    this->sent.clear();
+
+    core.handleMessage(serverMessage(MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM3)}, 3));
+    core.handleMessage(serverMessage(MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM4)}, 4));
+    ASSERT_EQ(this->sent.size(), 1);
+    EXPECT_EQ(this->sent[0].getMessagePayloadType(), MessagePayloadType::SYNC_REQUEST);
+    EXPECT_EQ(std::get<SyncRequestPayload>(this->sent[0].getMessagePayload()).fromSequence, 1);
+    // 被丢弃的事件不通知决策者
+    EXPECT_EQ(policy.updates, 1);
+}
+
+TEST_F(ClientCoreTest, BotPlaysFirstPlayableCard)
+{
+    BotPolicy policy;
+    ClientCore core(MessageEncoding::BINARY, this->sender(), policy);
+    core.handleMessage(initGame(1, {Card(CardColor::BLUE, CardType::NUM5), Card(CardColor::RED, CardType::NUM7)}));
+
+    ASSERT_EQ(this->sent.size(), 2);
+    ASSERT_EQ(this->sent[1].getMessagePayloadType(), MessagePayloadType::PLAY_CARD);
+    auto played = std::get<PlayCardPayload>(this->sent[1].getMessagePayload()).card;
+    EXPECT_EQ(played.getColor(), CardColor::RED);
+    EXPECT_EQ(played.getType(), CardType::NUM7);
+    EXPECT_TRUE(core.isWaiting());
+
+    // 自己的出牌被广播回来之后轮到对方，机器人不再行动
+    core.handleMessage(serverMessage(MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM7)}, 2));
+    EXPECT_FALSE(core.isWaiting());
+    EXPECT_EQ(core.getGameState()->getClientGameStage(), ClientGameStage::IDLE);
+    EXPECT_EQ(this->sent.size(), 2);
+}
+
+TEST_F(ClientCoreTest, BotDrawsAndReadiesAfterGame)
+{
+    BotPolicy policy;
+    ClientCore core(MessageEncoding::BINARY, this->sender(), policy);
+    core.handleMessage(initGame(1, {Card(CardColor::BLUE, CardType::NUM5)}));
+    ASSERT_EQ(this->sent.size(), 2);
+    EXPECT_EQ(this->sent[1].getMessagePayloadType(), MessagePayloadType::DRAW_CARD);
+
+    // 服务端拒绝后不再等待
+    core.handleMessage(MessageSerializer::serialize({MessageStatus::INVALID, MessagePayloadType::EMPTY, {}}));
+    EXPECT_FALSE(core.isWaiting());
+    EXPECT_EQ(core.getRejected(), 1);
+
+    core.handleMessage(serverMessage(MessagePayloadType::END_GAME, EndGamePayload{}, 2));
+    EXPECT_EQ(core.getGamesEnded(), 1);
+    ASSERT_EQ(this->sent.size(), 4);
+    EXPECT_EQ(this->sent[2].getMessagePayloadType(), MessagePayloadType::ACK);
+    EXPECT_EQ(this->sent[3].getMessagePayloadType(), MessagePayloadType::START_GAME);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file HeadlessClientTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+
+#include "../../../src/client/HeadlessClient.h"
+
+#include <asio.hpp>
+#include <gtest/gtest.h>
+
+using namespace UNO::CLIENT;
+
+TEST(HeadlessClientTest, RunReturnsWhenServerUnreachable)
+{
+    // 先占用一个端口再释放，保证没有服务端在监听
+    uint16_t port = 0;
+    {
+        asio::io_context io_context;
+        asio::ip::tcp::acceptor acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+        port = acceptor.local_endpoint().port();
+    }
+
+    HeadlessOptions options;
+    options.name       = "bot";
+    options.host       = "127.0.0.1";
+    options.port       = port;
+    options.readyDelay = std::chrono::milliseconds(0);
+
+    // 连接失败后 run 必须返回而不是一直等待
+    HeadlessClient client(options);
+    EXPECT_FALSE(client.run());
+    EXPECT_EQ(client.getGamesEnded(), 0);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file BinaryCodecTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.13
+ */
+
+#include "../../../src/common/BinaryCodec.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::COMMON;
+
+TEST(BinaryCodecTest, VarintSmallValueUsesOneByte)
+{
+    BinaryWriter writer;
+    writer.writeVarint(127);
+    EXPECT_EQ(writer.getData().size(), 1);
+
+    BinaryReader reader(writer.getData());
+    EXPECT_EQ(reader.readVarint(), 127);
+    EXPECT_TRUE(reader.isEnd());
+}
+
+TEST(BinaryCodecTest, VarintRoundTrip)
+{
+    std::vector<uint64_t> values = {0, 1, 128, 300, 16383, 16384, 1ULL << 32, UINT64_MAX};
+
+    BinaryWriter writer;
+    for (auto value : values) {
+        writer.writeVarint(value);
+    }
+
+    BinaryReader reader(writer.getData());
+    for (auto value : values) {
+        EXPECT_EQ(reader.readVarint(), value);
+    }
+    EXPECT_TRUE(reader.isEnd());
+}
+
+TEST(BinaryCodecTest, StringRoundTrip)
+{
+    BinaryWriter writer;
+    writer.writeString("");
+    writer.writeString("Player<>\"&\n\t");
+    writer.writeString(std::string(1000, 'x'));
+
+    BinaryReader reader(writer.getData());
+    EXPECT_EQ(reader.readString(), "");
+    EXPECT_EQ(reader.readString(), "Player<>\"&\n\t");
+    EXPECT_EQ(reader.readString(), std::string(1000, 'x'));
+    EXPECT_TRUE(reader.isEnd());
+}
+
+TEST(BinaryCodecTest, ReadPastEndThrows)
+{
+    BinaryReader reader("");
+    EXPECT_THROW(reader.readByte(), std::invalid_argument);
+}
+
+TEST(BinaryCodecTest, TruncatedVarintThrows)
+{
+    std::string data = "\x80\x80";
+    BinaryReader reader(data);
+    EXPECT_THROW(reader.readVarint(), std::invalid_argument);
+}
+
+TEST(BinaryCodecTest, OverlongVarintThrows)
+{
+    std::string data(11, '\x80');
+    BinaryReader reader(data);
+    EXPECT_THROW(reader.readVarint(), std::invalid_argument);
+}
+
+TEST(BinaryCodecTest, StringLengthBeyondDataThrows)
+{
+    BinaryWriter writer;
+    writer.writeVarint(10);
+    writer.writeByte('a');
+
+    BinaryReader reader(writer.getData());
+    EXPECT_THROW(reader.readString(), std::invalid_argument);
+}
+
+TEST(BinaryCodecTest, InvalidUtf8StringThrows)
+{
+    // 非法字节、代理区码点、截断的多字节字符
+    for (const auto *value : {"\xff", "\xed\xa0\x80", "ok\xe4\xbd"}) {
+        BinaryWriter writer;
+        writer.writeString(value);
+
+        BinaryReader reader(writer.getData());
+        EXPECT_THROW(reader.readString(), std::invalid_argument);
+    }
+}
+
+TEST(BinaryCodecTest, Utf8StringRoundTrip)
+{
+    BinaryWriter writer;
+    writer.writeString("\xe4\xbd\xa0\xe5\xa5\xbd");
+
+    BinaryReader reader(writer.getData());
+    EXPECT_EQ(reader.readString(), "\xe4\xbd\xa0\xe5\xa5\xbd");
+}
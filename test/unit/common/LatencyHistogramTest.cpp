@@ -0,0 +1,74 @@
+/**
+ * @file LatencyHistogramTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+
+#include "../../../src/common/LatencyHistogram.h"
+#include "../../../src/common/Metrics.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::COMMON;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValueOnce)
+{
+    // 相邻的桶首尾相接：每个桶的下界是前一个桶的上界加一
+    EXPECT_EQ(LatencyHistogram::bucketOf(0), 0);
+    for (size_t bucket = 1; bucket < LatencyHistogram::BucketCount; bucket++) {
+        auto lower = LatencyHistogram::upperBound(bucket - 1) + 1;
+        ASSERT_EQ(LatencyHistogram::bucketOf(lower), bucket);
+        ASSERT_EQ(LatencyHistogram::bucketOf(LatencyHistogram::upperBound(bucket)), bucket);
+    }
+    EXPECT_EQ(LatencyHistogram::upperBound(LatencyHistogram::BucketCount - 1), (uint64_t{1} << LatencyHistogram::MaxBits) - 1);
+    EXPECT_EQ(LatencyHistogram::bucketOf(UINT64_MAX), LatencyHistogram::BucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, RelativeErrorIsBounded)
+{
+    for (uint64_t value = 1; value < (uint64_t{1} << 36); value = value * 3 / 2 + 1) {
+        auto upper = LatencyHistogram::upperBound(LatencyHistogram::bucketOf(value));
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value) / static_cast<double>(value), 1.0 / 64);
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformLatencies)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.99), 0ns);
+
+    for (int i = 1; i <= 10000; i++) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    EXPECT_EQ(histogram.getCount(), 10000);
+    EXPECT_EQ(histogram.getSum(), 10000ull * 10001 / 2 * 1000);
+
+    auto expectNear = [&histogram](double quantile, std::chrono::microseconds expected) {
+        auto actual = std::chrono::duration<double, std::micro>(histogram.percentile(quantile)).count();
+        EXPECT_GE(actual, static_cast<double>(expected.count()));
+        EXPECT_LE(actual, static_cast<double>(expected.count()) * (1 + 1.0 / 64));
+    };
+    expectNear(0.5, 5000us);
+    expectNear(0.99, 9900us);
+    expectNear(0.999, 9990us);
+    expectNear(1.0, 10000us);
+}
+
+TEST(LatencyHistogramTest, WritesPrometheusSummary)
+{
+    LatencyHistogram histogram;
+    histogram.record(2ms);
+
+    PrometheusWriter writer;
+    writer.family("uno_turn_latency_seconds", "Turn latency", "summary");
+    writer.write("uno_turn_latency_seconds", "type=\"PLAY_CARD\"", histogram);
+
+    const auto &text = writer.str();
+    EXPECT_NE(text.find("# TYPE uno_turn_latency_seconds summary\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_turn_latency_seconds{type=\"PLAY_CARD\",quantile=\"0.999\"} 0.002"), std::string::npos);
+    EXPECT_NE(text.find("uno_turn_latency_seconds_sum{type=\"PLAY_CARD\"} 0.002\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_turn_latency_seconds_count{type=\"PLAY_CARD\"} 1\n"), std::string::npos);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file MetricsTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+
+#include "../../../src/common/Metrics.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace UNO::COMMON;
+using namespace std::chrono_literals;
+
+TEST(MetricsTest, CounterAndGauge)
+{
+    Counter counter;
+    counter.add();
+    counter.add(4);
+    EXPECT_EQ(counter.get(), 5);
+
+    Gauge gauge;
+    gauge.add(3);
+    gauge.add(-5);
+    EXPECT_EQ(gauge.get(), -2);
+    gauge.set(7);
+    EXPECT_EQ(gauge.get(), 7);
+}
+
+TEST(MetricsTest, ConcurrentUpdatesAreNotLost)
+{
+    Counter counter;
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 10000; j++) {
+                counter.add();
+                histogram.observe(1us);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.get(), 40000);
+    EXPECT_EQ(histogram.getBucket(0), 40000);
+    EXPECT_EQ(histogram.getSum(), 40000 * 1000);
+}
+
+TEST(MetricsTest, HistogramBuckets)
+{
+    Histogram histogram;
+    histogram.observe(1us);
+    histogram.observe(1001ns);
+    histogram.observe(1s);
+
+    EXPECT_EQ(histogram.getBucket(0), 1);
+    EXPECT_EQ(histogram.getBucket(1), 1);
+    EXPECT_EQ(histogram.getBucket(Histogram::BucketBounds.size()), 1);
+}
+
+TEST(MetricsTest, PrometheusText)
+{
+    Counter counter;
+    counter.add(3);
+    Histogram histogram;
+    histogram.observe(2ms);
+
+    PrometheusWriter writer;
+    writer.family("uno_test_total", "Test counter", "counter");
+    writer.write("uno_test_total", "type=\"PLAY_CARD\"", counter);
+    writer.family("uno_test_seconds", "Test histogram", "histogram");
+    writer.write("uno_test_seconds", "", histogram);
+
+    const auto &text = writer.str();
+    EXPECT_TRUE(text.starts_with("# HELP uno_test_total Test counter\n# TYPE uno_test_total counter\n"));
+    EXPECT_NE(text.find("uno_test_total{type=\"PLAY_CARD\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_test_seconds_bucket{le=\"0.001\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_test_seconds_bucket{le=\"0.0025\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_test_seconds_bucket{le=\"+Inf\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_test_seconds_sum 0.002\n"), std::string::npos);
+    EXPECT_NE(text.find("uno_test_seconds_count 1\n"), std::string::npos);
+}
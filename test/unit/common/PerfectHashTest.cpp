@@ -0,0 +1,36 @@
+/**
+ * @file PerfectHashTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.15
+ */
+
+#include "../../../src/common/PerfectHash.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::COMMON;
+using namespace std::string_view_literals;
+
+namespace {
+    constexpr std::array<std::string_view, 6> Keys = {"red"sv, "yellow"sv, "blue"sv, "green"sv, ""sv, "wild_draw_four"sv};
+    constexpr PerfectHash Hash(Keys);
+
+    static_assert(Hash.find("blue") == 2);
+    static_assert(Hash.find("purple").has_value() == false);
+}   // namespace
+
+TEST(PerfectHashTest, FindsEveryKey)
+{
+    for (size_t i = 0; i < Keys.size(); i++) {
+        ASSERT_EQ(Hash.find(Keys[i]), i);
+    }
+}
+
+TEST(PerfectHashTest, RejectsUnknownKeys)
+{
+    EXPECT_FALSE(Hash.find("Red").has_value());
+    EXPECT_FALSE(Hash.find("re").has_value());
+    EXPECT_FALSE(Hash.find("redd").has_value());
+    EXPECT_FALSE(Hash.find(" ").has_value());
+}
@@ -0,0 +1,86 @@
+/**
+ * @file TraceTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.19
+ */
+
+#include "../../../src/common/Trace.h"
+
+#include <format>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+using namespace UNO::COMMON;
+using namespace std::chrono_literals;
+
+TEST(TraceTest, RingBufferKeepsNewestEvents)
+{
+    TraceBuffer buffer(3, 1);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto *name : {"a", "b", "c", "d", "e"}) {
+        buffer.push({name, start, 1us});
+    }
+
+    auto events = buffer.events();
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_STREQ(events[0].name, "c");
+    EXPECT_STREQ(events[1].name, "d");
+    EXPECT_STREQ(events[2].name, "e");
+}
+
+TEST(TraceTest, SpansAreRecordedOnlyWhenEnabled)
+{
+    Tracer::disable();
+    {
+        TraceSpan span("disabled");
+    }
+
+    Tracer::enable();
+    {
+        TraceSpan span("main");
+    }
+    std::thread([]() { TraceSpan span("worker"); }).join();
+    Tracer::disable();
+
+    std::ostringstream out;
+    Tracer::writeChromeTrace(out);
+    auto json = out.str();
+    EXPECT_EQ(json.find("\"disabled\""), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"main","cat":"uno","ph":"X")"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"worker","cat":"uno","ph":"X")"), std::string::npos);
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0);
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+TEST(TraceTest, OverlappingAsyncSpansArePairedById)
+{
+    // 两个会话在同一线程上交错：a 先开始，b 在 a 结束前开始、在 a 结束后结束，不能作为嵌套的 "X" 事件输出
+    Tracer::enable();
+    auto first  = Tracer::newAsyncId();
+    auto second = Tracer::newAsyncId();
+    ASSERT_NE(first, second);
+    {
+        auto a = std::make_unique<TraceSpan>("a", first);
+        auto b = std::make_unique<TraceSpan>("b", second);
+        a.reset();
+        b.reset();
+    }
+    Tracer::disable();
+
+    std::ostringstream out;
+    Tracer::writeChromeTrace(out);
+    auto json = out.str();
+    EXPECT_EQ(json.find(R"("name":"a","cat":"uno","ph":"X")"), std::string::npos);
+    EXPECT_EQ(json.find(R"("name":"b","cat":"uno","ph":"X")"), std::string::npos);
+    for (auto [name, id] : {std::pair{"a", first}, std::pair{"b", second}}) {
+        auto begin = json.find(std::format(R"("name":"{}","cat":"uno","ph":"b","id":"0x{:x}")", name, id));
+        auto end   = json.find(std::format(R"("name":"{}","cat":"uno","ph":"e","id":"0x{:x}")", name, id));
+        EXPECT_NE(begin, std::string::npos);
+        EXPECT_NE(end, std::string::npos);
+        EXPECT_LT(begin, end);
+    }
+}
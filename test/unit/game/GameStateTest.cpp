@@ -20,7 +20,7 @@ TEST(game_state_test, game_state_test_1)
     UNO::GAME::ClientPlayerState playerState3("qkp", 100, false);
     UNO::GAME::ClientPlayerState playerState4("lzh", 100, false);
 
-    clientGameState.init({playerState1, playerState2, playerState3, playerState4}, {}, {}, 0, 3);
+    clientGameState.init({playerState1, playerState2, playerState3, playerState4}, UNO::GAME::DiscardPile(), {}, 0, 3);
 
     const auto &players = clientGameState.getPlayers();
     ASSERT_EQ(players[0].getName(), "pkq");
@@ -130,7 +130,10 @@ TEST(game_state_test, game_state_test_2)
                 break;
             }
 
-            if (it->canBePlayedOn(serverGameState.getDiscardPile().getFront(), serverGameState.getDrawCount())) {
+            ASSERT_TRUE(player.hasCard(*it));
+            ASSERT_EQ(serverGameState.canPlay(*it),
+                      it->canBePlayedOn(serverGameState.getDiscardPile().getFront(), serverGameState.getDrawCount()));
+            if (serverGameState.canPlay(*it)) {
                 auto card        = *it;
                 size_t prevCount = player.getCards().count(card);
 
@@ -157,4 +160,41 @@ TEST(game_state_test, game_state_test_2)
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(game_state_test, game_state_test_3)
+{
+    UNO::GAME::ClientGameState clientGameState;
+
+    UNO::GAME::DiscardPile discardPile;
+    discardPile.add({UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM1});
+    clientGameState.init({{"pkq", 2, false}, {"kpq", 2, false}},
+                         discardPile,
+                         {{UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM2}, {UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM3}},
+                         0,
+                         0);
+
+    // 快照替换之前的全部状态，而不是与之合并
+    clientGameState.sync({{"pkq", 1, true}, {"kpq", 5, false}},
+                         {UNO::GAME::Card(UNO::GAME::CardColor::BLUE, UNO::GAME::CardType::DRAW2), 9},
+                         {{UNO::GAME::CardColor::GREEN, UNO::GAME::CardType::NUM4}},
+                         1,
+                         0,
+                         true,
+                         2);
+
+    ASSERT_EQ(clientGameState.getCards().size(), 1);
+    ASSERT_EQ(clientGameState.getCards().begin()->getColor(), UNO::GAME::CardColor::GREEN);
+    ASSERT_EQ(clientGameState.getDiscardPile().getFront().getType(), UNO::GAME::CardType::DRAW2);
+    ASSERT_EQ(clientGameState.getPlayers()[1].getRemainingCardCount(), 5);
+    ASSERT_EQ(clientGameState.getCurrentPlayerId(), 1);
+    ASSERT_EQ(clientGameState.getClientGameStage(), UNO::GAME::ClientGameStage::IDLE);
+    ASSERT_TRUE(clientGameState.getIsReversed());
+    ASSERT_EQ(clientGameState.getDrawCount(), 2);
+    ASSERT_EQ(clientGameState.getDiscardSummary().size, 9);
+
+    // 客户端只保存摘要，但牌数随出牌与服务端保持一致
+    clientGameState.updateStateByCard({UNO::GAME::CardColor::BLUE, UNO::GAME::CardType::DRAW2});
+    ASSERT_EQ(clientGameState.getDiscardSummary().size, 10);
+    ASSERT_EQ(clientGameState.getDiscardSummary().top->getColor(), UNO::GAME::CardColor::BLUE);
+}
@@ -36,4 +36,34 @@ TEST(player_test, player_test_1)
     ASSERT_EQ(handCard.getCards().begin()->getType(), UNO::GAME::CardType::NUM0);
 
     ASSERT_EQ(handCard.isEmpty(), false);
-}
\ No newline at end of file
+}
+
+TEST(player_test, player_test_2)
+{
+    UNO::GAME::HandCard handCard;
+    handCard.draw(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5));
+
+    std::multiset<UNO::GAME::Card> cards = {UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5),
+                                            UNO::GAME::Card(UNO::GAME::CardColor::BLUE, UNO::GAME::CardType::NUM1)};
+    handCard.draw(std::move(cards));
+
+    ASSERT_EQ(handCard.getCards().size(), 3);
+    ASSERT_EQ(handCard.getCards().count(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5)), 2);
+}
+
+TEST(player_test, player_test_3)
+{
+    UNO::GAME::HandCard handCard;
+    handCard.draw(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5));
+    handCard.draw(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::WILD));
+
+    ASSERT_TRUE(handCard.contains(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5)));
+    ASSERT_FALSE(handCard.contains(UNO::GAME::Card(UNO::GAME::CardColor::BLUE, UNO::GAME::CardType::NUM5)));
+    // 万能牌打出时可以指定任意颜色
+    ASSERT_TRUE(handCard.contains(UNO::GAME::Card(UNO::GAME::CardColor::GREEN, UNO::GAME::CardType::WILD)));
+    ASSERT_FALSE(handCard.contains(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::WILDDRAWFOUR)));
+
+    handCard.play(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5));
+    ASSERT_FALSE(handCard.contains(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5)));
+    ASSERT_THROW(handCard.play(UNO::GAME::Card(UNO::GAME::CardColor::RED, UNO::GAME::CardType::NUM5)), std::invalid_argument);
+}
@@ -0,0 +1,220 @@
+/**
+ * @file BinaryMessageSerializerTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.13
+ */
+
+#include "../../../src/network/BinaryMessageSerializer.h"
+#include "../../../src/network/MessageSerializer.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::NETWORK;
+using namespace UNO::GAME;
+
+namespace {
+    Message roundTrip(const Message &message)
+    {
+        auto data = MessageSerializer::serialize(message, MessageEncoding::BINARY);
+        EXPECT_EQ(MessageSerializer::detectEncoding(data), MessageEncoding::BINARY);
+        return MessageSerializer::deserialize(data);
+    }
+
+    void expectSameCard(const Card &actual, const Card &expected)
+    {
+        EXPECT_EQ(actual.getColor(), expected.getColor());
+        EXPECT_EQ(actual.getType(), expected.getType());
+    }
+
+    InitGamePayload makeInitGamePayload()
+    {
+        DiscardPile discardPile;
+        discardPile.add(Card(CardColor::RED, CardType::NUM5));
+        discardPile.add(Card(CardColor::BLUE, CardType::SKIP));
+
+        return {1,
+                {ClientPlayerState("Alice", 7, false), ClientPlayerState("Bob", 1, true)},
+                discardPile.getSummary(),
+                {Card(CardColor::GREEN, CardType::NUM3), Card(CardColor::RED, CardType::WILDDRAWFOUR)},
+                0,
+                discardPile};
+    }
+}   // namespace
+
+// ========== Round Trip Tests ==========
+
+TEST(BinaryMessageSerializerTest, JoinGameRoundTrip)
+{
+    auto result = roundTrip({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"Player<>\"&\n\t"}});
+
+    EXPECT_EQ(result.getMessageStatus(), MessageStatus::OK);
+    EXPECT_EQ(result.getMessagePayloadType(), MessagePayloadType::JOIN_GAME);
+    EXPECT_EQ(std::get<JoinGamePayload>(result.getMessagePayload()).playerName, "Player<>\"&\n\t");
+}
+
+TEST(BinaryMessageSerializerTest, EmptyPayloadsRoundTrip)
+{
+    auto empty = roundTrip({MessageStatus::INVALID, MessagePayloadType::EMPTY, std::monostate{}});
+    EXPECT_EQ(empty.getMessageStatus(), MessageStatus::INVALID);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(empty.getMessagePayload()));
+
+    auto start = roundTrip({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}});
+    EXPECT_EQ(start.getMessagePayloadType(), MessagePayloadType::START_GAME);
+    EXPECT_TRUE(std::holds_alternative<StartGamePayload>(start.getMessagePayload()));
+
+    auto end = roundTrip({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}});
+    EXPECT_EQ(end.getMessagePayloadType(), MessagePayloadType::END_GAME);
+    EXPECT_TRUE(std::holds_alternative<EndGamePayload>(end.getMessagePayload()));
+}
+
+TEST(BinaryMessageSerializerTest, DrawCardRoundTrip)
+{
+    std::vector<Card> cards = {Card(CardColor::RED, CardType::NUM0), Card(CardColor::GREEN, CardType::WILDDRAWFOUR)};
+    auto result             = roundTrip({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{200, cards}});
+
+    auto payload = std::get<DrawCardPayload>(result.getMessagePayload());
+    EXPECT_EQ(payload.drawCount, 200);
+    ASSERT_EQ(payload.cards.size(), 2);
+    expectSameCard(payload.cards[0], cards[0]);
+    expectSameCard(payload.cards[1], cards[1]);
+}
+
+TEST(BinaryMessageSerializerTest, PlayCardRoundTripAllCards)
+{
+    for (auto color : AllColors) {
+        for (auto type : AllTypes) {
+            auto result = roundTrip({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(color, type)}});
+            expectSameCard(std::get<PlayCardPayload>(result.getMessagePayload()).card, Card(color, type));
+        }
+    }
+}
+
+TEST(BinaryMessageSerializerTest, PlayCardIsFourBytes)
+{
+    Message message(MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::DRAW2)});
+    auto data = MessageSerializer::serialize(message, MessageEncoding::BINARY);
+    EXPECT_EQ(data.size(), 4);
+}
+
+TEST(BinaryMessageSerializerTest, InitGameRoundTrip)
+{
+    auto expected = makeInitGamePayload();
+    auto result   = roundTrip({MessageStatus::OK, MessagePayloadType::INIT_GAME, expected});
+
+    auto payload = std::get<InitGamePayload>(result.getMessagePayload());
+    EXPECT_EQ(payload.playerId, 1);
+    EXPECT_EQ(payload.currentPlayerIndex, 0);
+
+    ASSERT_EQ(payload.players.size(), 2);
+    EXPECT_EQ(payload.players[0].getName(), "Alice");
+    EXPECT_EQ(payload.players[0].getRemainingCardCount(), 7);
+    EXPECT_FALSE(payload.players[0].getIsUno());
+    EXPECT_EQ(payload.players[1].getName(), "Bob");
+    EXPECT_EQ(payload.players[1].getRemainingCardCount(), 1);
+    EXPECT_TRUE(payload.players[1].getIsUno());
+
+    EXPECT_EQ(payload.discardSummary.size, 2);
+    expectSameCard(*payload.discardSummary.top, Card(CardColor::BLUE, CardType::SKIP));
+
+    ASSERT_TRUE(payload.discardPile.has_value());
+    ASSERT_EQ(payload.discardPile->getCards().size(), 2);
+    expectSameCard(payload.discardPile->getFront(), Card(CardColor::BLUE, CardType::SKIP));
+    expectSameCard(payload.discardPile->getCards()[1], Card(CardColor::RED, CardType::NUM5));
+
+    ASSERT_EQ(payload.handCard.size(), 2);
+    EXPECT_EQ(payload.handCard.count(Card(CardColor::GREEN, CardType::NUM3)), 1);
+    EXPECT_EQ(payload.handCard.count(Card(CardColor::RED, CardType::WILDDRAWFOUR)), 1);
+}
+
+TEST(BinaryMessageSerializerTest, InitGameWithoutFullDiscardPile)
+{
+    auto expected = makeInitGamePayload();
+    auto withPile = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::INIT_GAME, expected}, MessageEncoding::BINARY);
+    expected.discardPile.reset();
+    auto data = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::INIT_GAME, expected}, MessageEncoding::BINARY);
+    EXPECT_LT(data.size(), withPile.size());
+
+    auto payload = std::get<InitGamePayload>(MessageSerializer::deserialize(data).getMessagePayload());
+    EXPECT_FALSE(payload.discardPile.has_value());
+    EXPECT_EQ(payload.discardSummary.size, 2);
+    expectSameCard(*payload.discardSummary.top, Card(CardColor::BLUE, CardType::SKIP));
+}
+
+TEST(BinaryMessageSerializerTest, InitGameIsMuchSmallerThanJson)
+{
+    Message message(MessageStatus::OK, MessagePayloadType::INIT_GAME, makeInitGamePayload());
+    auto binary = MessageSerializer::serialize(message, MessageEncoding::BINARY);
+    auto json   = MessageSerializer::serialize(message, MessageEncoding::JSON);
+    EXPECT_LT(binary.size() * 10, json.size());
+}
+
+// ========== Encoding Detection Tests ==========
+
+TEST(BinaryMessageSerializerTest, DetectJsonEncoding)
+{
+    auto data = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}});
+    EXPECT_EQ(MessageSerializer::detectEncoding(data), MessageEncoding::JSON);
+    EXPECT_EQ(MessageSerializer::detectEncoding(""), MessageEncoding::JSON);
+}
+
+// ========== Invalid Data Tests ==========
+
+TEST(BinaryMessageSerializerTest, TruncatedMessageThrows)
+{
+    auto data = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::INIT_GAME, makeInitGamePayload()},
+                                             MessageEncoding::BINARY);
+    for (size_t length = 1; length < data.size(); length++) {
+        EXPECT_THROW(MessageSerializer::deserialize(data.substr(0, length)), std::invalid_argument);
+    }
+}
+
+TEST(BinaryMessageSerializerTest, TrailingBytesThrow)
+{
+    auto data = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}},
+                                             MessageEncoding::BINARY);
+    EXPECT_THROW(MessageSerializer::deserialize(data + '\0'), std::invalid_argument);
+}
+
+TEST(BinaryMessageSerializerTest, InvalidStatusThrows)
+{
+    std::string data = {static_cast<char>(BinaryMessageSerializer::FrameTag), 2, 0};
+    EXPECT_THROW(MessageSerializer::deserialize(data), std::invalid_argument);
+}
+
+TEST(BinaryMessageSerializerTest, InvalidPayloadTypeThrows)
+{
+    std::string data = {static_cast<char>(BinaryMessageSerializer::FrameTag), 0, 100};
+    EXPECT_THROW(MessageSerializer::deserialize(data), std::invalid_argument);
+}
+
+TEST(BinaryMessageSerializerTest, InvalidCardThrows)
+{
+    auto invalidColor = std::string{static_cast<char>(BinaryMessageSerializer::FrameTag), 0, 4, 0x40};
+    EXPECT_THROW(MessageSerializer::deserialize(invalidColor), std::invalid_argument);
+
+    auto invalidType = std::string{static_cast<char>(BinaryMessageSerializer::FrameTag), 0, 4, 0x0F};
+    EXPECT_THROW(MessageSerializer::deserialize(invalidType), std::invalid_argument);
+}
+
+TEST(BinaryMessageSerializerTest, HugeCardCountThrows)
+{
+    // DRAW_CARD，draw_count = 1，cards 数量为 2^35 但没有后续数据
+    std::string data = {static_cast<char>(BinaryMessageSerializer::FrameTag), 0, 3, 1, '\x80', '\x80', '\x80', '\x80', '\x80', 0x01};
+    EXPECT_THROW(MessageSerializer::deserialize(data), std::invalid_argument);
+}
+
+TEST(BinaryMessageSerializerTest, SequencedFrame)
+{
+    auto sequenced = roundTrip({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}, 300});
+    EXPECT_EQ(sequenced.getSequence(), 300);
+
+    auto data = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}, 300},
+                                             MessageEncoding::BINARY);
+    EXPECT_EQ(static_cast<uint8_t>(data.front()), BinaryMessageSerializer::SequencedFrameTag);
+    EXPECT_EQ(roundTrip({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}}).getSequence(), NoSequence);
+
+    // 带序号的帧不允许写入 NoSequence
+    std::string zero = {static_cast<char>(BinaryMessageSerializer::SequencedFrameTag), 0, 0, 6};
+    EXPECT_THROW(MessageSerializer::deserialize(zero), std::invalid_argument);
+}
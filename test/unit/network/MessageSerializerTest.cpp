@@ -195,7 +195,7 @@ TEST(MessageSerializerTest, SerializeInitGameMessage)
     handCard.draw(Card(CardColor::GREEN, CardType::NUM3));
     handCard.draw(Card(CardColor::YELLOW, CardType::REVERSE));
 
-    InitGamePayload payload{1, {}, discardPile, handCard.getCards(), 2};
+    InitGamePayload payload{1, {}, discardPile.getSummary(), handCard.getCards(), 2, std::nullopt};
     Message message(MessageStatus::OK, MessagePayloadType::INIT_GAME, payload);
 
     std::string result  = MessageSerializer::serialize(message);
@@ -205,18 +205,34 @@ TEST(MessageSerializerTest, SerializeInitGameMessage)
     EXPECT_EQ(json["payload_type"], "INIT_GAME");
     EXPECT_EQ(json["payload"]["player_id"], 1);
     EXPECT_EQ(json["payload"]["current_player"], 2);
-    EXPECT_TRUE(json["payload"]["discard_pile"].is_array());
+    EXPECT_EQ(json["payload"]["discard"]["size"], 2);
+    EXPECT_EQ(json["payload"]["discard"]["top"]["card_color"], "blue");
+    EXPECT_EQ(json["payload"]["discard"]["top"]["card_type"], "skip");
+    EXPECT_FALSE(json["payload"].contains("discard_pile"));
     EXPECT_TRUE(json["payload"]["hand_card"].is_array());
-    EXPECT_EQ(json["payload"]["discard_pile"].size(), 2);
     EXPECT_EQ(json["payload"]["hand_card"].size(), 2);
 }
 
+TEST(MessageSerializerTest, SerializeInitGameMessageWithFullDiscardPile)
+{
+    DiscardPile discardPile;
+    discardPile.add(Card(CardColor::RED, CardType::NUM5));
+    discardPile.add(Card(CardColor::BLUE, CardType::SKIP));
+
+    InitGamePayload payload{1, {}, discardPile.getSummary(), {}, 2, discardPile};
+    nlohmann::json json = nlohmann::json::parse(MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::INIT_GAME, payload}));
+
+    EXPECT_TRUE(json["payload"]["discard_pile"].is_array());
+    EXPECT_EQ(json["payload"]["discard_pile"].size(), 2);
+    EXPECT_EQ(json["payload"]["discard"]["size"], 2);
+}
+
 TEST(MessageSerializerTest, SerializeInitGameMessageWithEmptyPiles)
 {
     DiscardPile discardPile;
     HandCard handCard;
 
-    InitGamePayload payload{0, {}, discardPile, handCard.getCards(), 0};
+    InitGamePayload payload{0, {}, discardPile.getSummary(), handCard.getCards(), 0, discardPile};
     Message message(MessageStatus::OK, MessagePayloadType::INIT_GAME, payload);
 
     std::string result  = MessageSerializer::serialize(message);
@@ -226,6 +242,8 @@ TEST(MessageSerializerTest, SerializeInitGameMessageWithEmptyPiles)
     EXPECT_EQ(json["payload_type"], "INIT_GAME");
     EXPECT_EQ(json["payload"]["player_id"], 0);
     EXPECT_EQ(json["payload"]["current_player"], 0);
+    EXPECT_EQ(json["payload"]["discard"]["size"], 0);
+    EXPECT_TRUE(json["payload"]["discard"]["top"].is_null());
     EXPECT_TRUE(json["payload"]["discard_pile"].is_array());
     EXPECT_TRUE(json["payload"]["hand_card"].is_array());
     EXPECT_EQ(json["payload"]["discard_pile"].size(), 0);
@@ -403,6 +421,33 @@ TEST(MessageSerializerTest, DeserializeInitGameMessage)
     auto payload = std::get<InitGamePayload>(message.getMessagePayload());
     EXPECT_EQ(payload.playerId, 42);
     EXPECT_EQ(payload.currentPlayerIndex, 2);
+    // 只带完整弃牌堆的旧格式：摘要由弃牌堆得出
+    EXPECT_EQ(payload.discardSummary.size, 1);
+    EXPECT_EQ(payload.discardSummary.top->getColor(), CardColor::RED);
+    EXPECT_TRUE(payload.discardPile.has_value());
+}
+
+TEST(MessageSerializerTest, DeserializeInitGameMessageWithDiscardSummary)
+{
+    std::string json = R"({"status_code":"OK","payload_type":"INIT_GAME","payload":{"player_id":0,"players":[],
+        "discard":{"size":40,"top":{"card_color":"green","card_type":"wild_wild"}},"hand_card":[],"current_player":0}})";
+
+    auto payload = std::get<InitGamePayload>(MessageSerializer::deserialize(json).getMessagePayload());
+    EXPECT_EQ(payload.discardSummary.size, 40);
+    EXPECT_EQ(payload.discardSummary.top->getColor(), CardColor::GREEN);
+    EXPECT_EQ(payload.discardSummary.top->getType(), CardType::WILD);
+    EXPECT_FALSE(payload.discardPile.has_value());
+}
+
+TEST(MessageSerializerTest, DeserializeInitGameWithInconsistentDiscardSummary)
+{
+    std::string nonEmptyWithoutTop = R"({"status_code":"OK","payload_type":"INIT_GAME","payload":{"player_id":0,"players":[],
+        "discard":{"size":3,"top":null},"hand_card":[],"current_player":0}})";
+    EXPECT_THROW(MessageSerializer::deserialize(nonEmptyWithoutTop), std::invalid_argument);
+
+    std::string emptyWithTop = R"({"status_code":"OK","payload_type":"INIT_GAME","payload":{"player_id":0,"players":[],
+        "discard":{"size":0,"top":{"card_color":"red","card_type":"5"}},"hand_card":[],"current_player":0}})";
+    EXPECT_THROW(MessageSerializer::deserialize(emptyWithTop), std::invalid_argument);
 }
 
 TEST(MessageSerializerTest, DeserializeEndGameMessage)
@@ -1207,3 +1252,276 @@ TEST(MessageSerializerTest, DeserializePathTraversalAttempt)
     auto payload     = std::get<JoinGamePayload>(message.getMessagePayload());
     EXPECT_EQ(payload.playerName, "../../etc/passwd");
 }
+
+// ========== Byte-identical Output Tests ==========
+
+namespace {
+    /**
+     * nlohmann::json 解析后再 dump 得到的是键有序的紧凑格式，直接写出的 JSON 必须与之逐字节相同
+     */
+    void expectCanonicalJson(const Message &message)
+    {
+        std::string result = MessageSerializer::serialize(message);
+        EXPECT_EQ(result, nlohmann::json::parse(result).dump());
+    }
+}   // namespace
+
+TEST(MessageSerializerTest, SerializeOutputMatchesNlohmannDump)
+{
+    DiscardPile discardPile;
+    discardPile.add(Card(CardColor::RED, CardType::NUM5));
+    discardPile.add(Card(CardColor::BLUE, CardType::WILDDRAWFOUR));
+
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::EMPTY, std::monostate{}});
+    expectCanonicalJson({MessageStatus::INVALID, MessagePayloadType::EMPTY, std::monostate{}});
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"Player<>\"&\\/\n\t\b\f\r\x01\x1f\x7f"}});
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"玩家 🎮"}});
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}});
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{0, {}}});
+    expectCanonicalJson({MessageStatus::OK,
+                         MessagePayloadType::DRAW_CARD,
+                         DrawCardPayload{2, {Card(CardColor::RED, CardType::NUM0), Card(CardColor::GREEN, CardType::DRAW2)}}});
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::YELLOW, CardType::WILD)}});
+    expectCanonicalJson({MessageStatus::OK,
+                         MessagePayloadType::INIT_GAME,
+                         InitGamePayload{3,
+                                         {ClientPlayerState("Alice", 7, false), ClientPlayerState("Bob", 18446744073709551615ULL, true)},
+                                         discardPile.getSummary(),
+                                         {Card(CardColor::GREEN, CardType::NUM3), Card(CardColor::RED, CardType::REVERSE)},
+                                         1,
+                                         discardPile}});
+    expectCanonicalJson(
+        {MessageStatus::OK, MessagePayloadType::INIT_GAME, InitGamePayload{0, {}, DiscardPile().getSummary(), {}, 0, std::nullopt}});
+    expectCanonicalJson({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}});
+}
+
+TEST(MessageSerializerTest, SerializeIntoReusedBuffer)
+{
+    std::string buffer = "stale contents";
+    MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}}, buffer);
+    EXPECT_EQ(buffer, R"({"payload":null,"payload_type":"START_GAME","status_code":"OK"})");
+
+    MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}}, buffer);
+    EXPECT_EQ(buffer, R"({"payload":null,"payload_type":"END_GAME","status_code":"OK"})");
+}
+
+TEST(MessageSerializerTest, SerializeInvalidUtf8NameThrows)
+{
+    EXPECT_THROW(MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"bad\xff"}}),
+                 std::invalid_argument);
+    EXPECT_THROW(MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"\xc0\xaf"}}),
+                 std::invalid_argument);
+    EXPECT_THROW(MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"\xed\xa0\x80"}}),
+                 std::invalid_argument);
+}
+
+// ========== Streaming Deserializer Compatibility Tests ==========
+
+TEST(MessageSerializerTest, DeserializeDuplicateKeysLastWins)
+{
+    std::string json =
+        R"({"status_code":"OK","payload_type":"JOIN_GAME","payload":{"name":1,"name":"Player1"},"payload_type":"PLAY_CARD","payload":{"card":{"card_color":5,"card_type":"skip","card_color":"blue"}}})";
+    Message message = MessageSerializer::deserialize(json);
+    EXPECT_EQ(message.getMessagePayloadType(), MessagePayloadType::PLAY_CARD);
+    auto payload = std::get<PlayCardPayload>(message.getMessagePayload());
+    EXPECT_EQ(payload.card.getColor(), CardColor::BLUE);
+    EXPECT_EQ(payload.card.getType(), CardType::SKIP);
+}
+
+TEST(MessageSerializerTest, DeserializeEscapedKeysAndValues)
+{
+    std::string json =
+        R"({"status_code":"OK","payload_type":"PLAY_CARD","payload":{"card":{"card\u005fcolor":"r\u0065d","card_type":"draw\u005Ftwo"}}})";
+    Message message = MessageSerializer::deserialize(json);
+    auto payload    = std::get<PlayCardPayload>(message.getMessagePayload());
+    EXPECT_EQ(payload.card.getColor(), CardColor::RED);
+    EXPECT_EQ(payload.card.getType(), CardType::DRAW2);
+}
+
+TEST(MessageSerializerTest, DeserializeSurrogatePairName)
+{
+    std::string json = R"({"status_code":"OK","payload_type":"JOIN_GAME","payload":{"name":"\ud83c\udfae"}})";
+    Message message  = MessageSerializer::deserialize(json);
+    EXPECT_EQ(std::get<JoinGamePayload>(message.getMessagePayload()).playerName, "🎮");
+}
+
+TEST(MessageSerializerTest, DeserializeWithByteOrderMark)
+{
+    std::string json = "\xEF\xBB\xBF" R"({"status_code":"OK","payload_type":"START_GAME","payload":null})";
+    EXPECT_EQ(MessageSerializer::deserialize(json).getMessagePayloadType(), MessagePayloadType::START_GAME);
+}
+
+TEST(MessageSerializerTest, DeserializeInvalidJsonInIgnoredFieldThrows)
+{
+    std::vector<std::string> inputs = {
+        R"({"status_code":"OK","payload_type":"START_GAME","payload":null,"extra":[1,2,]})",
+        R"({"status_code":"OK","payload_type":"START_GAME","payload":null,"extra":"\ud800"})",
+        R"({"status_code":"OK","payload_type":"START_GAME","payload":null,"extra":01})",
+        R"({"status_code":"OK","payload_type":"START_GAME","payload":null,"extra":1e999})",
+        "{\"status_code\":\"OK\",\"payload_type\":\"START_GAME\",\"payload\":null,\"extra\":\"\xff\"}",
+        R"({"status_code":"OK","payload_type":"START_GAME","payload":null} trailing)",
+    };
+    for (const auto &json : inputs) {
+        EXPECT_THROW(MessageSerializer::deserialize(json), std::invalid_argument) << json;
+    }
+}
+
+TEST(MessageSerializerTest, DeserializeNonUnsignedNumbersThrow)
+{
+    std::vector<std::string> drawCounts = {"-0", "-1", "1.0", "1e2", "18446744073709551616"};
+    for (const auto &drawCount : drawCounts) {
+        std::string json =
+            R"({"status_code":"OK","payload_type":"DRAW_CARD","payload":{"draw_count":)" + drawCount + R"(,"cards":[]}})";
+        EXPECT_THROW(MessageSerializer::deserialize(json), std::invalid_argument) << drawCount;
+    }
+
+    std::string json = R"({"status_code":"OK","payload_type":"DRAW_CARD","payload":{"draw_count":18446744073709551615,"cards":[]}})";
+    EXPECT_EQ(std::get<DrawCardPayload>(MessageSerializer::deserialize(json).getMessagePayload()).drawCount, 18446744073709551615ULL);
+}
+
+// ========== Cached Frame Tests ==========
+
+TEST(MessageSerializerTest, CachedFramesMatchSerialize)
+{
+    for (auto encoding : {MessageEncoding::JSON, MessageEncoding::BINARY}) {
+        for (auto color : AllColors) {
+            for (auto type : AllTypes) {
+                Message message(MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(color, type)});
+                EXPECT_EQ(*MessageSerializer::playCardFrame(Card(color, type), encoding), MessageSerializer::serialize(message, encoding));
+            }
+        }
+        for (size_t count = 1; count <= MessageSerializer::MaxCachedDrawCount; count++) {
+            Message message(MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{count, {}});
+            EXPECT_EQ(*MessageSerializer::drawCountFrame(count, encoding), MessageSerializer::serialize(message, encoding));
+        }
+        EXPECT_EQ(*MessageSerializer::startGameFrame(encoding),
+                  MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}}, encoding));
+        EXPECT_EQ(*MessageSerializer::endGameFrame(encoding),
+                  MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}}, encoding));
+        EXPECT_EQ(*MessageSerializer::invalidFrame(encoding),
+                  MessageSerializer::serialize({MessageStatus::INVALID, MessagePayloadType::EMPTY, std::monostate{}}, encoding));
+    }
+}
+
+TEST(MessageSerializerTest, CachedDrawCountOutOfRangeThrows)
+{
+    EXPECT_THROW(MessageSerializer::drawCountFrame(0, MessageEncoding::JSON), std::invalid_argument);
+    EXPECT_THROW(MessageSerializer::drawCountFrame(MessageSerializer::MaxCachedDrawCount + 1, MessageEncoding::BINARY),
+                 std::invalid_argument);
+}
+
+TEST(MessageSerializerTest, FindCachedFrame)
+{
+    Message playCard(MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::GREEN, CardType::DRAW2)});
+    EXPECT_EQ(MessageSerializer::findCachedFrame(playCard, MessageEncoding::BINARY),
+              MessageSerializer::playCardFrame(Card(CardColor::GREEN, CardType::DRAW2), MessageEncoding::BINARY));
+
+    Message countOnly(MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{2, {}});
+    EXPECT_EQ(MessageSerializer::findCachedFrame(countOnly, MessageEncoding::JSON),
+              MessageSerializer::drawCountFrame(2, MessageEncoding::JSON));
+
+    // 带牌面的摸牌消息、超出缓存范围的摸牌数和 INIT_GAME 都没有缓存
+    Message withCards(MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{1, {Card(CardColor::RED, CardType::NUM1)}});
+    EXPECT_EQ(MessageSerializer::findCachedFrame(withCards, MessageEncoding::JSON), nullptr);
+    Message manyCards(MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{MessageSerializer::MaxCachedDrawCount + 1, {}});
+    EXPECT_EQ(MessageSerializer::findCachedFrame(manyCards, MessageEncoding::JSON), nullptr);
+    Message invalid(MessageStatus::INVALID, MessagePayloadType::EMPTY, std::monostate{});
+    EXPECT_EQ(MessageSerializer::findCachedFrame(invalid, MessageEncoding::BINARY), nullptr);
+}
+
+TEST(MessageSerializerTest, SerializeSequencedMessage)
+{
+    Message message(MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM1)}, 42);
+    auto json = nlohmann::json::parse(MessageSerializer::serialize(message));
+
+    EXPECT_EQ(json["sequence"], 42);
+
+    // 不属于状态流的消息不写出 sequence，旧的客户端可以照常解析
+    Message unsequenced(MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM1)});
+    EXPECT_FALSE(nlohmann::json::parse(MessageSerializer::serialize(unsequenced)).contains("sequence"));
+}
+
+TEST(MessageSerializerTest, DeserializeInvalidSequence)
+{
+    std::string data = R"({"payload":null,"payload_type":"END_GAME","sequence":-1,"status_code":"OK"})";
+    EXPECT_THROW(MessageSerializer::deserialize(data), std::invalid_argument);
+}
+
+TEST(MessageSerializerTest, RoundTripStateSyncMessages)
+{
+    std::vector<ClientPlayerState> players = {{"Alice", 3, false}, {"Bob", 1, true}};
+    SyncPayload sync                       = {
+        1, players, {Card(CardColor::BLUE, CardType::SKIP), 12}, {Card(CardColor::RED, CardType::NUM2)}, 0, true, 4};
+
+    for (auto encoding : {MessageEncoding::JSON, MessageEncoding::BINARY}) {
+        auto ack = MessageSerializer::deserialize(
+            MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::ACK, AckPayload{17}}, encoding));
+        EXPECT_EQ(std::get<AckPayload>(ack.getMessagePayload()).sequence, 17);
+
+        auto request = MessageSerializer::deserialize(
+            MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::SYNC_REQUEST, SyncRequestPayload{9}}, encoding));
+        EXPECT_EQ(std::get<SyncRequestPayload>(request.getMessagePayload()).fromSequence, 9);
+
+        auto decoded = MessageSerializer::deserialize(
+            MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::SYNC, sync, 30}, encoding));
+        EXPECT_EQ(decoded.getSequence(), 30);
+        const auto &payload = std::get<SyncPayload>(decoded.getMessagePayload());
+        EXPECT_EQ(payload.playerId, 1);
+        ASSERT_EQ(payload.players.size(), 2);
+        EXPECT_EQ(payload.players[1].getName(), "Bob");
+        EXPECT_TRUE(payload.players[1].getIsUno());
+        EXPECT_EQ(payload.discardSummary.top->getType(), CardType::SKIP);
+        EXPECT_EQ(payload.discardSummary.size, 12);
+        EXPECT_EQ(payload.handCard.size(), 1);
+        EXPECT_EQ(payload.currentPlayerIndex, 0);
+        EXPECT_TRUE(payload.isReversed);
+        EXPECT_EQ(payload.drawCount, 4);
+    }
+}
+
+TEST(MessageSerializerTest, AddSequenceMatchesSerialize)
+{
+    for (auto encoding : {MessageEncoding::JSON, MessageEncoding::BINARY}) {
+        for (uint64_t sequence : {1ULL, 127ULL, 128ULL, 1ULL << 40}) {
+            Message drawCard(MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{2, {}}, sequence);
+            EXPECT_EQ(MessageSerializer::addSequence(*MessageSerializer::drawCountFrame(2, encoding), sequence, encoding),
+                      MessageSerializer::serialize(drawCard, encoding));
+            EXPECT_EQ(*MessageSerializer::findCachedFrame(drawCard, encoding), MessageSerializer::serialize(drawCard, encoding));
+            EXPECT_EQ(MessageSerializer::deserialize(MessageSerializer::serialize(drawCard, encoding)).getSequence(), sequence);
+        }
+    }
+}
+
+TEST(MessageSerializerTest, SerializeResumeJoinGameMessage)
+{
+    auto result = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"Player1", "00ff", 42}});
+    EXPECT_EQ(result,
+              R"({"payload":{"last_sequence":42,"name":"Player1","resume_token":"00ff"},"payload_type":"JOIN_GAME","status_code":"OK"})");
+
+    // 没有令牌时与旧版本的 JOIN_GAME 完全相同
+    auto plain = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"Player1"}});
+    EXPECT_EQ(plain, R"({"payload":{"name":"Player1"},"payload_type":"JOIN_GAME","status_code":"OK"})");
+}
+
+TEST(MessageSerializerTest, DeserializeResumeJoinGameWithoutSequenceThrows)
+{
+    std::string json = R"({"status_code":"OK","payload_type":"JOIN_GAME","payload":{"name":"Player1","resume_token":"00ff"}})";
+    EXPECT_THROW(MessageSerializer::deserialize(json), std::invalid_argument);
+}
+
+TEST(MessageSerializerTest, RoundTripSessionMessages)
+{
+    for (auto encoding : {MessageEncoding::JSON, MessageEncoding::BINARY}) {
+        auto join = MessageSerializer::deserialize(
+            MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"Player1", "00ff", 300}}, encoding));
+        auto joinPayload = std::get<JoinGamePayload>(join.getMessagePayload());
+        EXPECT_EQ(joinPayload.playerName, "Player1");
+        EXPECT_EQ(joinPayload.resumeToken, "00ff");
+        EXPECT_EQ(joinPayload.lastSequence, 300);
+
+        auto session = MessageSerializer::deserialize(
+            MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::SESSION, SessionPayload{"00ff"}}, encoding));
+        EXPECT_EQ(session.getMessagePayloadType(), MessagePayloadType::SESSION);
+        EXPECT_EQ(std::get<SessionPayload>(session.getMessagePayload()).resumeToken, "00ff");
+    }
+}
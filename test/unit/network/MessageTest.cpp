@@ -0,0 +1,47 @@
+/**
+ * @file MessageTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.17
+ */
+
+#include "../../../src/network/Message.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::NETWORK;
+using namespace UNO::GAME;
+
+namespace {
+    Message makeInitGameMessage()
+    {
+        InitGamePayload payload = {0,
+                                   {ClientPlayerState("Alice", 7, false), ClientPlayerState("Bob", 7, false)},
+                                   DiscardPile().getSummary(),
+                                   {Card(CardColor::RED, CardType::NUM1), Card(CardColor::BLUE, CardType::SKIP)},
+                                   1,
+                                   std::nullopt};
+        return {MessageStatus::OK, MessagePayloadType::INIT_GAME, std::move(payload)};
+    }
+}   // namespace
+
+TEST(MessageTest, PayloadAccessByReference)
+{
+    const auto message = makeInitGameMessage();
+
+    EXPECT_EQ(&message.getMessagePayload(), &message.getMessagePayload());
+    EXPECT_EQ(std::get<InitGamePayload>(message.getMessagePayload()).players.size(), 2);
+}
+
+TEST(MessageTest, PayloadMoveOut)
+{
+    auto message       = makeInitGameMessage();
+    const auto *before = std::get<InitGamePayload>(message.getMessagePayload()).players.data();
+
+    auto payload = std::get<InitGamePayload>(std::move(message).getMessagePayload());
+
+    // 移出不复制，玩家列表的存储被直接接管
+    EXPECT_EQ(payload.players.data(), before);
+    EXPECT_EQ(payload.handCard.size(), 2);
+    EXPECT_EQ(payload.currentPlayerIndex, 1);
+}
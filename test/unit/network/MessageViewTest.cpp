@@ -0,0 +1,74 @@
+/**
+ * @file MessageViewTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.16
+ */
+
+#include "../../../src/network/MessageView.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::NETWORK;
+using namespace UNO::GAME;
+
+namespace {
+    Message makePlayCardMessage()
+    {
+        return {MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::BLUE, CardType::REVERSE)}};
+    }
+}   // namespace
+
+TEST(MessageViewTest, HeaderFromJson)
+{
+    auto data = MessageSerializer::serialize(makePlayCardMessage(), MessageEncoding::JSON);
+    MessageView view(data);
+
+    EXPECT_EQ(view.getEncoding(), MessageEncoding::JSON);
+    EXPECT_EQ(view.getMessageStatus(), MessageStatus::OK);
+    EXPECT_EQ(view.getMessagePayloadType(), MessagePayloadType::PLAY_CARD);
+
+    auto card = std::get<PlayCardPayload>(view.decode().getMessagePayload()).card;
+    EXPECT_EQ(card.getColor(), CardColor::BLUE);
+    EXPECT_EQ(card.getType(), CardType::REVERSE);
+}
+
+TEST(MessageViewTest, HeaderFromBinary)
+{
+    auto data = MessageSerializer::serialize(makePlayCardMessage(), MessageEncoding::BINARY);
+    MessageView view(data);
+
+    EXPECT_EQ(view.getEncoding(), MessageEncoding::BINARY);
+    EXPECT_EQ(view.getMessageStatus(), MessageStatus::OK);
+    EXPECT_EQ(view.getMessagePayloadType(), MessagePayloadType::PLAY_CARD);
+
+    auto card = std::get<PlayCardPayload>(view.decode().getMessagePayload()).card;
+    EXPECT_EQ(card.getColor(), CardColor::BLUE);
+    EXPECT_EQ(card.getType(), CardType::REVERSE);
+}
+
+TEST(MessageViewTest, MalformedJsonPayloadFailsOnlyOnDecode)
+{
+    std::string data = R"({"payload":{"card":{"color":"purple","type":"1"}},"payload_type":"PLAY_CARD","status_code":"OK"})";
+    MessageView view(data);
+
+    EXPECT_EQ(view.getMessagePayloadType(), MessagePayloadType::PLAY_CARD);
+    EXPECT_THROW(view.decode(), std::invalid_argument);
+}
+
+TEST(MessageViewTest, MalformedBinaryPayloadFailsOnlyOnDecode)
+{
+    auto data = MessageSerializer::serialize(makePlayCardMessage(), MessageEncoding::BINARY);
+    data.push_back('\0');
+    MessageView view(data);
+
+    EXPECT_EQ(view.getMessagePayloadType(), MessagePayloadType::PLAY_CARD);
+    EXPECT_THROW(view.decode(), std::invalid_argument);
+}
+
+TEST(MessageViewTest, MalformedHeaderThrows)
+{
+    EXPECT_THROW(MessageView(R"({"payload":{},"payload_type":"UNKNOWN","status_code":"OK"})"), std::invalid_argument);
+    EXPECT_THROW(MessageView(R"({"payload":{},"payload_type":"EMPTY")"), std::invalid_argument);
+    EXPECT_THROW(MessageView(std::string("\x01\x00", 2)), std::invalid_argument);
+}
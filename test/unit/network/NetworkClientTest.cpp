@@ -151,3 +151,35 @@ TEST(NetworkClientTest, SendAfterConnect)
         netThread.join();
     }
 }
+
+TEST(NetworkClientTest, ConnectFailureCallsOnConnectFailed)
+{
+    // 先占用一个端口再释放，保证没有服务端在监听
+    uint16_t port = 0;
+    {
+        asio::io_context io_context;
+        asio::ip::tcp::acceptor acceptor(io_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+        port = acceptor.local_endpoint().port();
+    }
+
+    std::atomic<bool> is_connected{false};
+    std::atomic<bool> is_failed{false};
+
+    auto on_connect = [&is_connected]() { is_connected = true; };
+    auto callback   = [](std::string message) {};
+    NetworkClient client(on_connect, callback, {}, [&is_failed]() { is_failed = true; });
+
+    auto netThread = std::thread([&client]() { client.run(); });
+
+    client.connect("127.0.0.1", port);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    EXPECT_FALSE(is_connected);
+    EXPECT_TRUE(is_failed);
+
+    client.stop();
+    if (netThread.joinable()) {
+        netThread.join();
+    }
+}
@@ -8,11 +8,13 @@
 #include "../../../src/network/NetworkServer.h"
 
 #include <asio.hpp>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <gtest/gtest.h>
 #include <mutex>
 #include <set>
+#include <stdexcept>
 #include <thread>
 #include <utility>
 
@@ -234,8 +236,9 @@ TEST(NetworkServerTest, SendMessageToInvalidPlayer)
 
     NetworkServer server(20005, callback);
 
-    // Try to send to non-existent player
-    EXPECT_THROW({ server.send(999, "test message"); }, std::invalid_argument);
+    // Messages to a non-existent player are dropped
+    EXPECT_FALSE(server.hasPlayer(999));
+    EXPECT_NO_THROW({ server.send(999, "test message"); });
 }
 
 TEST(NetworkServerTest, SendEmptyMessage)
@@ -504,6 +507,202 @@ TEST(SessionTest, SessionInvokesCallbackOnIncomingMessage)
     EXPECT_EQ(received_message, message);
 }
 
+TEST(SessionTest, SessionDisconnectsOversizedMessage)
+{
+    asio::io_context server_context;
+    asio::ip::tcp::acceptor acceptor(server_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+    uint16_t port = acceptor.local_endpoint().port();
+
+    auto stats = std::make_shared<SessionStats>();
+    std::atomic<bool> callback_called{false};
+    std::atomic<bool> closed{false};
+
+    acceptor.async_accept([&](const asio::error_code &ec, asio::ip::tcp::socket socket) {
+        if (!ec) {
+            auto session = std::make_shared<Session>(std::move(socket), SessionLimits::forPlayers(10, 16), stats);
+            session->start([&](std::string message) { callback_called = true; }, [&]() { closed = true; });
+        }
+    });
+
+    std::thread server_thread([&]() { server_context.run(); });
+
+    asio::io_context client_context;
+    asio::ip::tcp::socket client_socket(client_context);
+    client_socket.connect(asio::ip::tcp::endpoint(asio::ip::address::from_string("127.0.0.1"), port));
+
+    // 字节桶容量为 64，更长的消息在读取消息体之前就被拒绝
+    std::string message(100, 'x');
+    size_t length = message.size();
+    asio::write(client_socket, asio::buffer(&length, sizeof(length)));
+    asio::write(client_socket, asio::buffer(message));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    server_context.stop();
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+
+    EXPECT_FALSE(callback_called);
+    EXPECT_TRUE(closed);
+    EXPECT_EQ(stats->disconnected.get(), 1);
+    EXPECT_EQ(stats->active.get(), 0);
+}
+
+TEST(SessionTest, SessionClosesWhenCallbackThrows)
+{
+    asio::io_context server_context;
+    asio::ip::tcp::acceptor acceptor(server_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+    uint16_t port = acceptor.local_endpoint().port();
+
+    auto stats = std::make_shared<SessionStats>();
+    std::atomic<size_t> received{0};
+    std::atomic<bool> closed{false};
+
+    acceptor.async_accept([&](const asio::error_code &ec, asio::ip::tcp::socket socket) {
+        if (!ec) {
+            auto session = std::make_shared<Session>(std::move(socket), SessionLimits{}, stats);
+            session->start(
+                [&](std::string message) {
+                    received++;
+                    throw std::runtime_error("handler failed");
+                },
+                [&]() { closed = true; });
+        }
+    });
+
+    std::thread server_thread([&]() { server_context.run(); });
+
+    asio::io_context client_context;
+    asio::ip::tcp::socket client_socket(client_context);
+    client_socket.connect(asio::ip::tcp::endpoint(asio::ip::address::from_string("127.0.0.1"), port));
+
+    // 两条消息一起发出，第一条的回调抛出异常后第二条不再被处理
+    std::string message = "boom";
+    size_t length       = message.size();
+    std::string frames;
+    for (int i = 0; i < 2; ++i) {
+        frames.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        frames += message;
+    }
+    asio::write(client_socket, asio::buffer(frames));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 连接被关闭，客户端读到 EOF
+    std::array<char, 16> buffer{};
+    asio::error_code ec;
+    client_socket.read_some(asio::buffer(buffer), ec);
+
+    server_context.stop();
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+
+    EXPECT_EQ(received, 1);
+    EXPECT_TRUE(closed);
+    EXPECT_TRUE(ec == asio::error::eof || ec == asio::error::connection_reset);
+    EXPECT_EQ(stats->active.get(), 0);
+}
+
+TEST(SessionTest, SessionDisconnectsSustainedFlood)
+{
+    asio::io_context server_context;
+    asio::ip::tcp::acceptor acceptor(server_context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+    uint16_t port = acceptor.local_endpoint().port();
+
+    auto stats = std::make_shared<SessionStats>();
+    std::atomic<size_t> received{0};
+    std::atomic<bool> closed{false};
+
+    // 每条消息单独看只需等待 10ms，远小于 maxThrottleDelay，但持续超速时等待不断累计
+    auto limits             = SessionLimits::forPlayers(100);
+    limits.maxThrottleDelay = std::chrono::milliseconds(200);
+    limits.throttleWindow   = std::chrono::milliseconds(1000);
+
+    acceptor.async_accept([&](const asio::error_code &ec, asio::ip::tcp::socket socket) {
+        if (!ec) {
+            auto session = std::make_shared<Session>(std::move(socket), limits, stats);
+            session->start([&](std::string message) { received++; }, [&]() { closed = true; });
+        }
+    });
+
+    std::thread server_thread([&]() { server_context.run(); });
+
+    asio::io_context client_context;
+    asio::ip::tcp::socket client_socket(client_context);
+    client_socket.connect(asio::ip::tcp::endpoint(asio::ip::address::from_string("127.0.0.1"), port));
+
+    std::string message = "flood";
+    size_t length       = message.size();
+    std::string flood;
+    for (int i = 0; i < 2000; ++i) {
+        flood.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        flood += message;
+    }
+    asio::write(client_socket, asio::buffer(flood));
+
+    for (int i = 0; i < 50 && closed == false; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    server_context.stop();
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+
+    // 突发的 200 条立即放行，之后按 100 条每秒放行，直到等待预算耗尽
+    EXPECT_TRUE(closed);
+    EXPECT_GT(received, 200);
+    EXPECT_LT(received, 2000);
+    EXPECT_GT(stats->throttled.get(), 0);
+    EXPECT_EQ(stats->disconnected.get(), 1);
+    EXPECT_EQ(stats->active.get(), 0);
+}
+
+TEST(NetworkServerTest, ThrottledPlayerIsRemoved)
+{
+    std::atomic<size_t> received{0};
+    auto callback = [&received](size_t player_id, std::string message) { received++; };
+
+    auto limits             = SessionLimits::forPlayers(100);
+    limits.maxThrottleDelay = std::chrono::milliseconds(200);
+    limits.throttleWindow   = std::chrono::milliseconds(1000);
+    NetworkServer server(0, callback, limits);
+
+    std::thread server_thread([&server]() { server.run(); });
+
+    asio::io_context io_context;
+    asio::ip::tcp::socket socket(io_context);
+    socket.connect(asio::ip::tcp::endpoint(asio::ip::address::from_string("127.0.0.1"), server.getPort()));
+
+    std::string message = "flood";
+    size_t length       = message.size();
+    std::string flood;
+    for (int i = 0; i < 2000; ++i) {
+        flood.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        flood += message;
+    }
+    asio::write(socket, asio::buffer(flood));
+
+    for (int i = 0; i < 50 && server.getSessionStats().disconnected.get() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 因持续超速被断开的连接从会话表中移除，之后发给它的消息被丢弃
+    EXPECT_EQ(server.getSessionStats().disconnected.get(), 1);
+    EXPECT_EQ(server.getSessionStats().active.get(), 0);
+    EXPECT_FALSE(server.hasPlayer(0));
+    EXPECT_NO_THROW({ server.send(0, "Message after disconnect"); });
+    EXPECT_LT(received, 2000);
+
+    server.stop();
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+}
+
 // ========== Concurrent Access Tests ==========
 
 TEST(NetworkServerTest, ConcurrentSendToSamePlayer)
@@ -670,7 +869,8 @@ TEST(NetworkServerTest, SendAfterPlayerDisconnect)
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-    // Player 0 should still exist in the session map even after disconnect
+    // Player 0 is removed once the connection closes, later messages are dropped
+    EXPECT_FALSE(server.hasPlayer(0));
     EXPECT_NO_THROW({ server.send(0, "Message after disconnect"); });
 
     server.stop();
@@ -678,3 +878,56 @@ TEST(NetworkServerTest, SendAfterPlayerDisconnect)
         server_thread.join();
     }
 }
+
+TEST(NetworkServerTest, SendSharedMessageToMultiplePlayers)
+{
+    auto callback = [](size_t player_id, std::string message) {};
+
+    NetworkServer server(20014, callback);
+
+    std::thread server_thread([&server]() { server.run(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::vector<std::unique_ptr<asio::io_context>> contexts;
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> sockets;
+
+    for (int i = 0; i < 3; ++i) {
+        contexts.push_back(std::make_unique<asio::io_context>());
+        sockets.push_back(std::make_unique<asio::ip::tcp::socket>(*contexts.back()));
+
+        asio::ip::tcp::resolver resolver(*contexts.back());
+        auto endpoints = resolver.resolve("127.0.0.1", "20014");
+        asio::connect(*sockets.back(), endpoints);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 所有玩家共享同一个缓冲区
+    auto message = std::make_shared<const std::string>("Shared message");
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_NO_THROW({ server.send(i, message); });
+    }
+
+    for (auto &socket : sockets) {
+        size_t length;
+        asio::read(*socket, asio::buffer(&length, sizeof(length)));
+        std::string received(length, '\0');
+        asio::read(*socket, asio::buffer(received));
+        EXPECT_EQ(received, "Shared message");
+    }
+
+    for (auto &socket : sockets) {
+        socket->close();
+    }
+    for (auto &context : contexts) {
+        context->stop();
+    }
+
+    server.stop();
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file TokenBucketTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+
+#include "../../../src/network/TokenBucket.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::NETWORK;
+using namespace std::chrono_literals;
+
+TEST(TokenBucketTest, BurstIsFree)
+{
+    auto start = TokenBucket::Clock::now();
+    TokenBucket bucket(10, 5, start);
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(bucket.take(1, start), TokenBucket::Clock::duration::zero());
+    }
+    EXPECT_EQ(bucket.take(1, start), 100ms);
+}
+
+TEST(TokenBucketTest, DebtAccumulates)
+{
+    auto start = TokenBucket::Clock::now();
+    TokenBucket bucket(10, 1, start);
+
+    EXPECT_EQ(bucket.take(1, start), TokenBucket::Clock::duration::zero());
+    EXPECT_EQ(bucket.take(1, start), 100ms);
+    EXPECT_EQ(bucket.take(1, start), 200ms);
+
+    // 还清透支之后重新开始积累，但不超过容量
+    EXPECT_EQ(bucket.take(1, start + 10s), TokenBucket::Clock::duration::zero());
+    EXPECT_EQ(bucket.take(1, start + 10s), 100ms);
+}
+
+TEST(TokenBucketTest, UnlimitedNeverWaits)
+{
+    TokenBucket bucket(SessionLimits::Unlimited, SessionLimits::Unlimited);
+    EXPECT_EQ(bucket.take(1e12), TokenBucket::Clock::duration::zero());
+}
+
+TEST(TokenBucketTest, PlayerLimits)
+{
+    auto limits = SessionLimits::forPlayers(10, 1024);
+    EXPECT_EQ(limits.messageBurst, 20);
+    EXPECT_EQ(limits.byteBurst, 4096);
+    EXPECT_EQ(SessionLimits{}.bytesPerSecond, SessionLimits::Unlimited);
+}
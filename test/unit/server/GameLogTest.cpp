@@ -0,0 +1,179 @@
+/**
+ * @file GameLogTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.20
+ */
+
+#include "../../../src/server/GameLog.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+using namespace UNO::SERVER;
+using namespace UNO::GAME;
+
+namespace {
+    /**
+     * @return 玩家手牌的颜色与类型，便于比较
+     */
+    std::vector<std::pair<CardColor, CardType>> handOf(const ServerGameState &gameState, size_t player)
+    {
+        std::vector<std::pair<CardColor, CardType>> hand;
+        for (const auto &card : gameState.getPlayers()[player].getCards()) {
+            hand.emplace_back(card.getColor(), card.getType());
+        }
+        return hand;
+    }
+
+    /**
+     * 像服务端一样修改状态并记录日志：当前玩家打出第一张能出的牌（万能牌选蓝色），没有则摸牌
+     * @param turns 最多进行的回合数，有玩家出完牌时提前结束这一局
+     */
+    void playGame(ServerGameState &gameState, std::vector<GameLogRecord> &log, std::mt19937::result_type seed, size_t turns)
+    {
+        log.emplace_back(GameLogStart{seed});
+        gameState.init(seed);
+        for (size_t turn = 0; turn < turns; turn++) {
+            auto current     = gameState.getCurrentPlayerId();
+            const auto &hand = gameState.getPlayers()[current].getCards();
+            auto card        = std::ranges::find_if(hand, [&gameState](const Card &card) { return gameState.canPlay(card); });
+            if (card == hand.end()) {
+                log.emplace_back(GameLogDraw{current, gameState.updateStateByDraw().size()});
+                continue;
+            }
+
+            Card played = *card;
+            if (played.getType() == CardType::WILD || played.getType() == CardType::WILDDRAWFOUR) {
+                played = Card(CardColor::BLUE, played.getType());
+            }
+            log.emplace_back(GameLogPlay{current, played});
+            gameState.updateStateByCard(played);
+            if (gameState.getPlayers()[current].isEmpty()) {
+                log.emplace_back(GameLogEnd{current});
+                gameState.endGame();
+                return;
+            }
+        }
+    }
+
+    std::string encodeLog(const std::vector<GameLogRecord> &records)
+    {
+        UNO::COMMON::BinaryWriter writer;
+        for (const auto &record : records) {
+            GameLog::encode(writer, record);
+        }
+        return std::string(GameLog::Magic) + writer.getData();
+    }
+}   // namespace
+
+TEST(GameLogTest, RecordsRoundTrip)
+{
+    std::vector<GameLogRecord> records = {GameLogJoin{"alice"},
+                                          GameLogStart{123456789},
+                                          GameLogPlay{1, Card(CardColor::BLUE, CardType::WILDDRAWFOUR)},
+                                          GameLogDraw{2, 4},
+                                          GameLogEnd{1}};
+    auto segments                      = GameLog::decode(encodeLog(records));
+    ASSERT_EQ(segments.size(), 1);
+    const auto &decoded = segments.front();
+    ASSERT_EQ(decoded.size(), records.size());
+    EXPECT_EQ(std::get<GameLogJoin>(decoded[0]).playerName, "alice");
+    EXPECT_EQ(std::get<GameLogStart>(decoded[1]).seed, 123456789);
+    EXPECT_EQ(std::get<GameLogPlay>(decoded[2]).player, 1);
+    EXPECT_EQ(std::get<GameLogPlay>(decoded[2]).card.getColor(), CardColor::BLUE);
+    EXPECT_EQ(std::get<GameLogPlay>(decoded[2]).card.getType(), CardType::WILDDRAWFOUR);
+    EXPECT_EQ(std::get<GameLogDraw>(decoded[3]).count, 4);
+    EXPECT_EQ(std::get<GameLogEnd>(decoded[4]).winner, 1);
+}
+
+TEST(GameLogTest, MalformedLogIsRejected)
+{
+    EXPECT_THROW(GameLog::decode("not a log"), std::invalid_argument);
+
+    auto data = encodeLog({GameLogJoin{"alice"}});
+    EXPECT_THROW(GameLog::decode(data.substr(0, data.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(GameLog::decode(std::string(GameLog::Magic) + "\x7f"), std::invalid_argument);
+}
+
+TEST(GameLogTest, ReplayRebuildsGames)
+{
+    ServerGameState live;
+    std::vector<GameLogRecord> log;
+    for (const auto *name : {"alice", "bob", "carol"}) {
+        log.emplace_back(GameLogJoin{name});
+        live.addPlayer(ServerPlayerState(name, 0, false));
+    }
+    // 前两局打完，第三局停在中途；状态（当前玩家、方向、罚摸张数）会跨局延续
+    playGame(live, log, 1, 1000);
+    playGame(live, log, 2, 1000);
+    playGame(live, log, 3, 15);
+
+    ServerGameState replayed;
+    GameLog::replay(GameLog::decode(encodeLog(log)).front(), replayed);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(handOf(replayed, i), handOf(live, i));
+    }
+    EXPECT_EQ(replayed.getCurrentPlayerId(), live.getCurrentPlayerId());
+    EXPECT_EQ(replayed.getIsReversed(), live.getIsReversed());
+    EXPECT_EQ(replayed.getDrawCount(), live.getDrawCount());
+    EXPECT_EQ(replayed.getDiscardPile().getSummary().size, live.getDiscardPile().getSummary().size);
+}
+
+TEST(GameLogTest, DivergentLogIsRejected)
+{
+    ServerGameState live;
+    std::vector<GameLogRecord> log = {GameLogJoin{"alice"}, GameLogJoin{"bob"}};
+    live.addPlayer(ServerPlayerState("alice", 0, false));
+    live.addPlayer(ServerPlayerState("bob", 0, false));
+    playGame(live, log, 7, 0);
+    log.emplace_back(GameLogDraw{1 - live.getCurrentPlayerId(), 1});
+
+    ServerGameState replayed;
+    EXPECT_THROW(GameLog::replay(log, replayed), std::invalid_argument);
+}
+
+TEST(GameLogTest, SegmentsAreDecodedSeparately)
+{
+    auto first  = encodeLog({GameLogJoin{"alice"}, GameLogStart{1}});
+    auto second = encodeLog({GameLogJoin{"bob"}});
+    auto empty  = encodeLog({});
+
+    auto segments = GameLog::decode(first + empty + second);
+    ASSERT_EQ(segments.size(), 3);
+    EXPECT_EQ(segments[0].size(), 2);
+    EXPECT_TRUE(segments[1].empty());
+    ASSERT_EQ(segments[2].size(), 1);
+    EXPECT_EQ(std::get<GameLogJoin>(segments[2][0]).playerName, "bob");
+}
+
+TEST(GameLogTest, WriterAppendsOneSegmentPerRun)
+{
+    auto path = std::filesystem::temp_directory_path() / "uno-game-log-test.bin";
+    std::filesystem::remove(path);
+    {
+        GameLogWriter writer(path);
+        writer.append(GameLogJoin{"alice"});
+        writer.append(GameLogStart{42});
+        writer.append(GameLogDraw{0, 1});
+    }
+    {
+        GameLogWriter writer(path);
+        writer.append(GameLogJoin{"bob"});
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto segments = GameLog::decode(data);
+    ASSERT_EQ(segments.size(), 2);
+    ASSERT_EQ(segments[0].size(), 3);
+    EXPECT_EQ(std::get<GameLogStart>(segments[0][1]).seed, 42);
+    ASSERT_EQ(segments[1].size(), 1);
+    EXPECT_EQ(std::get<GameLogJoin>(segments[1][0]).playerName, "bob");
+    std::filesystem::remove(path);
+}
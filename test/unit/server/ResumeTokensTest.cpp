@@ -0,0 +1,41 @@
+/**
+ * @file ResumeTokensTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.18
+ */
+
+#include "../../../src/server/ResumeTokens.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::SERVER;
+
+TEST(ResumeTokensTest, IssuedTokenFindsSeat)
+{
+    ResumeTokens tokens;
+    auto first  = tokens.issue(0);
+    auto second = tokens.issue(1);
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(tokens.find(first), 0);
+    EXPECT_EQ(tokens.find(second), 1);
+}
+
+TEST(ResumeTokensTest, TokenIsHex)
+{
+    ResumeTokens tokens;
+    auto token = tokens.issue(0);
+
+    EXPECT_EQ(token.size(), ResumeTokens::TokenBytes * 2);
+    EXPECT_EQ(token.find_first_not_of("0123456789abcdef"), std::string::npos);
+}
+
+TEST(ResumeTokensTest, UnknownTokenIsRejected)
+{
+    ResumeTokens tokens;
+    tokens.issue(0);
+
+    EXPECT_EQ(tokens.find(""), std::nullopt);
+    EXPECT_EQ(tokens.find("00ff"), std::nullopt);
+}
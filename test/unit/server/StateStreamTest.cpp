@@ -0,0 +1,91 @@
+/**
+ * @file StateStreamTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.17
+ */
+
+#include "../../../src/server/StateStream.h"
+
+#include <gtest/gtest.h>
+
+using namespace UNO::NETWORK;
+using namespace UNO::SERVER;
+using namespace UNO::GAME;
+
+TEST(StateStreamTest, SequencesIncreaseAcrossGames)
+{
+    StateStream stream;
+    auto first = stream.beginGame(2);
+    EXPECT_EQ(stream.append(MessagePayloadType::END_GAME, EndGamePayload{}).publicView.getSequence(), first + 1);
+
+    auto second = stream.beginGame(2);
+    EXPECT_EQ(second, first + 2);
+    EXPECT_EQ(stream.getVersion(), second);
+    EXPECT_EQ(stream.deltaFor(0, second)->size(), 0);
+}
+
+TEST(StateStreamTest, DeltaUsesPrivateView)
+{
+    StateStream stream;
+    auto version = stream.beginGame(2);
+    stream.append(MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM1)});
+    stream.append(MessagePayloadType::DRAW_CARD,
+                  DrawCardPayload{1, {}},
+                  1,
+                  DrawCardPayload{1, {Card(CardColor::BLUE, CardType::NUM2)}});
+
+    auto drawer = stream.deltaFor(1, version);
+    ASSERT_TRUE(drawer.has_value());
+    ASSERT_EQ(drawer->size(), 2);
+    EXPECT_EQ((*drawer)[0].getSequence(), version + 1);
+    EXPECT_EQ((*drawer)[1].getSequence(), version + 2);
+    EXPECT_EQ(std::get<DrawCardPayload>((*drawer)[1].getMessagePayload()).cards.size(), 1);
+
+    auto other = stream.deltaFor(0, version + 1);
+    ASSERT_EQ(other->size(), 1);
+    EXPECT_TRUE(std::get<DrawCardPayload>((*other)[0].getMessagePayload()).cards.empty());
+
+    // 来自未来的版本无法补齐
+    EXPECT_FALSE(stream.deltaFor(0, version + 3).has_value());
+}
+
+TEST(StateStreamTest, AcknowledgedEventsAreDropped)
+{
+    StateStream stream;
+    auto version = stream.beginGame(2);
+    for (int i = 0; i < 4; i++) {
+        stream.append(MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM1)});
+    }
+
+    stream.acknowledge(0, version + 3);
+    EXPECT_TRUE(stream.deltaFor(1, version).has_value());
+
+    stream.acknowledge(1, version + 2);
+    EXPECT_FALSE(stream.deltaFor(1, version).has_value());
+    EXPECT_EQ(stream.deltaFor(1, version + 2)->size(), 2);
+}
+
+TEST(StateStreamTest, CapacityBoundsLog)
+{
+    StateStream stream(2);
+    auto version = stream.beginGame(1);
+    for (int i = 0; i < 5; i++) {
+        stream.append(MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM1)});
+    }
+
+    EXPECT_FALSE(stream.deltaFor(0, version).has_value());
+    EXPECT_FALSE(stream.deltaFor(0, version + 2).has_value());
+    EXPECT_EQ(stream.deltaFor(0, version + 3)->size(), 2);
+}
+
+TEST(StateStreamTest, AcknowledgeFromLateJoinerIsIgnored)
+{
+    StateStream stream;
+    stream.acknowledge(0, 1);
+
+    auto version = stream.beginGame(2);
+    stream.append(MessagePayloadType::END_GAME, EndGamePayload{});
+    stream.acknowledge(2, version + 1);
+    EXPECT_EQ(stream.deltaFor(0, version)->size(), 1);
+}
@@ -0,0 +1,373 @@
+/**
+ * @file UnoServerTest.cpp
+ *
+ * @author Yuzhe Guo
+ * @date 2025.12.29
+ */
+
+#include "../../../src/server/UnoServer.h"
+
+#include <array>
+#include <asio.hpp>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace UNO::SERVER;
+using namespace UNO::NETWORK;
+using namespace UNO::GAME;
+
+namespace {
+    /**
+     * @return 加上长度前缀的帧
+     */
+    std::string framed(const std::string &message)
+    {
+        size_t length = message.size();
+        std::string frame(reinterpret_cast<const char *>(&length), sizeof(length));
+        return frame + message;
+    }
+
+    /**
+     * 直接收发帧的玩家连接
+     */
+    class TestClient {
+    private:
+        asio::io_context context_;
+        asio::ip::tcp::socket socket_;
+
+    public:
+        explicit TestClient(uint16_t port) : socket_(context_)
+        {
+            this->socket_.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+        }
+
+        void sendFrame(const std::string &message)
+        {
+            asio::write(this->socket_, asio::buffer(framed(message)));
+        }
+
+        void send(const Message &message)
+        {
+            this->sendFrame(MessageSerializer::serialize(message));
+        }
+
+        /**
+         * @return 下一个帧，2 秒内没有收到时抛出异常
+         */
+        std::string receiveFrame()
+        {
+            size_t length = 0;
+            std::string body;
+            bool received = false;
+            asio::async_read(this->socket_, asio::buffer(&length, sizeof(length)), [&](const asio::error_code &ec, size_t) {
+                if (ec) {
+                    return;
+                }
+                body.resize(length);
+                asio::async_read(this->socket_, asio::buffer(body), [&](const asio::error_code &ec, size_t) { received = !ec; });
+            });
+            this->context_.restart();
+            this->context_.run_for(std::chrono::seconds(2));
+            if (received == false) {
+                this->socket_.cancel();
+                this->context_.restart();
+                this->context_.run();
+                throw std::runtime_error("no message from server");
+            }
+            return body;
+        }
+
+        Message receive()
+        {
+            return MessageSerializer::deserialize(this->receiveFrame());
+        }
+    };
+
+    /**
+     * 在后台线程运行的服务端与两名已经加入的玩家，端口由系统分配
+     */
+    class UnoServerRejectionTest : public testing::Test {
+    protected:
+        UnoServer server{0, false, SessionLimits{}};
+        std::thread serverThread;
+        std::vector<std::unique_ptr<TestClient>> players;
+        std::vector<InitGamePayload> inits;
+        std::vector<std::string> resumeTokens;
+
+        void SetUp() override
+        {
+            this->serverThread = std::thread([this]() { this->server.run(); });
+            for (auto name : {"alice", "bob"}) {
+                this->players.push_back(this->connect());
+                this->players.back()->send({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{name, "", 0}});
+                auto session = this->players.back()->receive();
+                ASSERT_EQ(session.getMessagePayloadType(), MessagePayloadType::SESSION);
+                this->resumeTokens.push_back(std::get<SessionPayload>(session.getMessagePayload()).resumeToken);
+            }
+        }
+
+        void TearDown() override
+        {
+            this->players.clear();
+            this->server.stop();
+            this->serverThread.join();
+        }
+
+        std::unique_ptr<TestClient> connect()
+        {
+            return std::make_unique<TestClient>(this->server.getPort());
+        }
+
+        /**
+         * 两名玩家都准备好，记录各自收到的开局消息
+         */
+        void startGame()
+        {
+            for (auto &player : this->players) {
+                player->send({MessageStatus::OK, MessagePayloadType::START_GAME, StartGamePayload{}});
+            }
+            for (auto &player : this->players) {
+                auto init = player->receive();
+                ASSERT_EQ(init.getMessagePayloadType(), MessagePayloadType::INIT_GAME);
+                this->inits.push_back(std::get<InitGamePayload>(init.getMessagePayload()));
+            }
+        }
+
+        size_t currentPlayer() const
+        {
+            return this->inits.front().currentPlayerIndex;
+        }
+
+        /**
+         * @return 第一名玩家看到的完整快照，对局状态不变时逐字节相同
+         */
+        std::string snapshot()
+        {
+            this->players.front()->send(
+                {MessageStatus::OK, MessagePayloadType::SYNC_REQUEST, SyncRequestPayload{std::numeric_limits<uint64_t>::max()}});
+            auto frame = this->players.front()->receiveFrame();
+            EXPECT_EQ(MessageSerializer::deserialize(frame).getMessagePayloadType(), MessagePayloadType::SYNC);
+            return frame;
+        }
+
+        static void expectInvalid(TestClient &client)
+        {
+            EXPECT_EQ(client.receive().getMessageStatus(), MessageStatus::INVALID);
+        }
+    };
+}   // namespace
+
+TEST(UnoServerTest, DestroyWithPendingWrites)
+{
+    auto server = std::make_unique<UnoServer>(0, false, SessionLimits{});
+    std::thread server_thread([&server]() { server->run(); });
+
+    // 客户端的接收缓冲区很小且从不读取，服务端的回复积压在发送队列中
+    asio::io_context io_context;
+    asio::ip::tcp::socket socket(io_context);
+    socket.open(asio::ip::tcp::v4());
+    socket.set_option(asio::socket_base::receive_buffer_size(1024));
+    socket.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), server->getPort()));
+
+    // 每条被拒绝的消息都会收到一个持有 TurnTrace 的 INVALID 回复
+    auto frame = framed(MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::EMPTY, std::monostate{}}));
+    std::string burst;
+    for (int i = 0; i < 1000; ++i) {
+        burst += frame;
+    }
+    for (int i = 0; i < 50; ++i) {
+        asio::write(socket, asio::buffer(burst));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // 析构时网络层释放未写完的消息，TurnTrace 记录延迟时指标必须仍然有效
+    server->stop();
+    server_thread.join();
+    EXPECT_NO_THROW(server.reset());
+
+    std::array<char, 4096> buffer{};
+    asio::error_code ec;
+    while (ec == asio::error_code()) {
+        socket.read_some(asio::buffer(buffer), ec);
+    }
+    EXPECT_TRUE(ec == asio::error::eof || ec == asio::error::connection_reset);
+}
+
+TEST_F(UnoServerRejectionTest, MalformedMessage)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    auto &current = *this->players[this->currentPlayer()];
+    auto card     = *this->inits[this->currentPlayer()].handCard.begin();
+    auto frame    = MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{card}});
+    current.sendFrame(frame.substr(0, frame.size() / 2));
+    expectInvalid(current);
+    current.sendFrame("not a message");
+    expectInvalid(current);
+
+    EXPECT_EQ(this->snapshot(), before);
+}
+
+TEST_F(UnoServerRejectionTest, InvalidUtf8NameFromBinaryClient)
+{
+    // 二进制编码本身不限制字节，名字如果被接受，服务端给 JSON 玩家序列化开局消息时会失败
+    auto mallory = this->connect();
+    mallory->sendFrame(MessageSerializer::serialize({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"\xff", "", 0}},
+                                                    MessageEncoding::BINARY));
+    expectInvalid(*mallory);
+
+    this->startGame();
+    ASSERT_EQ(this->inits.size(), 2);
+    EXPECT_EQ(this->inits.front().players.size(), 2);
+}
+
+TEST_F(UnoServerRejectionTest, ForbiddenPayloadType)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    auto &current = *this->players[this->currentPlayer()];
+    current.send({MessageStatus::OK, MessagePayloadType::END_GAME, EndGamePayload{}});
+    expectInvalid(current);
+
+    EXPECT_EQ(this->snapshot(), before);
+}
+
+TEST_F(UnoServerRejectionTest, NotJoined)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    auto stranger = this->connect();
+    stranger->send({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{1, {}}});
+    expectInvalid(*stranger);
+
+    EXPECT_EQ(this->snapshot(), before);
+}
+
+TEST_F(UnoServerRejectionTest, AlreadyJoined)
+{
+    auto &alice = *this->players.front();
+    alice.send({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"alice again", "", 0}});
+    expectInvalid(alice);
+
+    // 第二次加入没有占用新的座位
+    this->startGame();
+    ASSERT_EQ(this->inits.front().players.size(), 2);
+    EXPECT_EQ(this->inits.front().players[0].getName(), "alice");
+}
+
+TEST_F(UnoServerRejectionTest, ResumeAnotherSeat)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    // alice 已经坐在 0 号座位，拿到 bob 的令牌也不能接管 1 号座位
+    auto &alice = *this->players.front();
+    alice.send({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"alice", this->resumeTokens[1], 0}});
+    expectInvalid(alice);
+
+    EXPECT_EQ(this->snapshot(), before);
+    auto &bob = *this->players[1];
+    bob.send({MessageStatus::OK, MessagePayloadType::SYNC_REQUEST, SyncRequestPayload{std::numeric_limits<uint64_t>::max()}});
+    EXPECT_EQ(std::get<SyncPayload>(bob.receive().getMessagePayload()).playerId, 1);
+}
+
+TEST_F(UnoServerRejectionTest, WrongStage)
+{
+    auto &alice = *this->players.front();
+    alice.send({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{1, {}}});
+    expectInvalid(alice);
+    alice.send({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{Card(CardColor::RED, CardType::NUM1)}});
+    expectInvalid(alice);
+
+    // 开局前的摸牌与出牌都没有生效
+    this->startGame();
+    for (const auto &player : this->inits.front().players) {
+        EXPECT_EQ(player.getRemainingCardCount(), 7);
+    }
+    EXPECT_EQ(this->inits.front().handCard.size(), 7);
+}
+
+TEST_F(UnoServerRejectionTest, NotYourTurn)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    auto other = 1 - this->currentPlayer();
+    auto card  = *this->inits[other].handCard.begin();
+    this->players[other]->send({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{card}});
+    expectInvalid(*this->players[other]);
+    this->players[other]->send({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{1, {}}});
+    expectInvalid(*this->players[other]);
+
+    EXPECT_EQ(this->snapshot(), before);
+}
+
+TEST_F(UnoServerRejectionTest, IllegalCard)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    // 任意一张不在手中的数字牌
+    const auto &hand = this->inits[this->currentPlayer()].handCard;
+    std::optional<Card> missing;
+    for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::BLUE, CardColor::GREEN}) {
+        for (auto type : {CardType::NUM0, CardType::NUM5, CardType::NUM9}) {
+            if (missing.has_value() == false && hand.contains(Card(color, type)) == false) {
+                missing = Card(color, type);
+            }
+        }
+    }
+    ASSERT_TRUE(missing.has_value());
+
+    auto &current = *this->players[this->currentPlayer()];
+    current.send({MessageStatus::OK, MessagePayloadType::PLAY_CARD, PlayCardPayload{*missing}});
+    expectInvalid(current);
+
+    EXPECT_EQ(this->snapshot(), before);
+}
+
+TEST_F(UnoServerRejectionTest, OpponentDisconnected)
+{
+    this->startGame();
+
+    // 对手断线后会话被移除，当前玩家的操作照常广播，发给对手的消息被丢弃
+    auto other = 1 - this->currentPlayer();
+    this->players[other].reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto &current = *this->players[this->currentPlayer()];
+    current.send({MessageStatus::OK, MessagePayloadType::DRAW_CARD, DrawCardPayload{1, {}}});
+    auto reply = current.receive();
+    EXPECT_EQ(reply.getMessageStatus(), MessageStatus::OK);
+    EXPECT_EQ(reply.getMessagePayloadType(), MessagePayloadType::DRAW_CARD);
+
+    // 对手用令牌重连后回到原来的座位
+    this->players[other] = this->connect();
+    this->players[other]->send({MessageStatus::OK,
+                                MessagePayloadType::JOIN_GAME,
+                                JoinGamePayload{"", this->resumeTokens[other], std::numeric_limits<uint64_t>::max()}});
+    auto sync = this->players[other]->receive();
+    ASSERT_EQ(sync.getMessagePayloadType(), MessagePayloadType::SYNC);
+    EXPECT_EQ(std::get<SyncPayload>(sync.getMessagePayload()).playerId, other);
+}
+
+TEST_F(UnoServerRejectionTest, UnknownResumeToken)
+{
+    this->startGame();
+    auto before = this->snapshot();
+
+    auto stranger = this->connect();
+    stranger->send({MessageStatus::OK, MessagePayloadType::JOIN_GAME, JoinGamePayload{"mallory", "00112233445566778899aabbccddeeff", 0}});
+    expectInvalid(*stranger);
+
+    EXPECT_EQ(this->snapshot(), before);
+}